@@ -0,0 +1,195 @@
+/*****************************************************************************************************************
+ * File Name: BLAKE2s.c
+ * Date: 18/10/2026
+ * Driver: BLAKE2s Hash Utility Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/pgmspace.h>
+#include "BLAKE2s.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+#define BLAKE2S_ROUNDS                       10
+
+/*
+ * The rotations by 16 and 8 are byte moves on the 8-bit AVR, avr-gcc only emits bit shifts for 12 and 7.
+ * BLAKE2s was chosen over SHA-256 for its 32-bit words and its 10 rounds of additions, XORs and rotations.
+ */
+#define BLAKE2S_ROTR32(X, N)                 (((X) >> (N)) | BLAKE2S_U32((X) << (32 - (N))))
+
+/* Truncation to 32 bits, free on the AVR where uint32 is exactly 32 bits, needed by the host build */
+#define BLAKE2S_U32(X)                       ((X) & 0xFFFFFFFFUL)
+
+/* Mixing function G on the words A, B, C, D of the work vector with the message words X and Y */
+#define BLAKE2S_G(V, A, B, C, D, X, Y) \
+	do { \
+		V[A] = BLAKE2S_U32(V[A] + V[B] + (X));  V[D] = BLAKE2S_ROTR32(V[D] ^ V[A], 16); \
+		V[C] = BLAKE2S_U32(V[C] + V[D]);        V[B] = BLAKE2S_ROTR32(V[B] ^ V[C], 12); \
+		V[A] = BLAKE2S_U32(V[A] + V[B] + (Y));  V[D] = BLAKE2S_ROTR32(V[D] ^ V[A], 8);  \
+		V[C] = BLAKE2S_U32(V[C] + V[D]);        V[B] = BLAKE2S_ROTR32(V[B] ^ V[C], 7);  \
+	} while (0)
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const uint32 g_IV[8] =
+{
+	0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+	0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+/* Message schedule of every round, kept in flash (160 bytes) instead of the 2 KB of RAM */
+static const uint8 g_Sigma[BLAKE2S_ROUNDS][16] PROGMEM =
+{
+	{ 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+	{14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+	{11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4},
+	{ 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8},
+	{ 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13},
+	{ 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9},
+	{12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11},
+	{13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10},
+	{ 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5},
+	{10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0}
+};
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Read a little endian 32-bit word.
+ */
+static uint32 BLAKE2s_Load32(const uint8 *Data)
+{
+	return (uint32)Data[0] | ((uint32)Data[1] << 8) | ((uint32)Data[2] << 16) | ((uint32)Data[3] << 24);
+}
+
+/*
+ * Description:
+ * Compress the buffered block into the state, Last is TRUE for the final block.
+ */
+static void BLAKE2s_Compress(BLAKE2s_ContextType *Context, boolean Last)
+{
+	uint32 V[16];
+	uint32 M[16];
+	const uint8 *Sigma;
+	uint8 Round;
+	uint8 i;
+
+	for (i = 0; i < 16; i++)
+	{
+		M[i] = BLAKE2s_Load32(&Context->Buffer[4 * i]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		V[i] = Context->State[i];
+		V[i + 8] = g_IV[i];
+	}
+
+	V[12] ^= Context->Counter;
+	if (Last)
+	{
+		V[14] = BLAKE2S_U32(~V[14]);
+	}
+
+	for (Round = 0; Round < BLAKE2S_ROUNDS; Round++)
+	{
+		Sigma = g_Sigma[Round];
+
+		/* Columns then diagonals, the work vector indexes are constants so no pointer arithmetic on V */
+		BLAKE2S_G(V, 0, 4,  8, 12, M[pgm_read_byte(&Sigma[0])],  M[pgm_read_byte(&Sigma[1])]);
+		BLAKE2S_G(V, 1, 5,  9, 13, M[pgm_read_byte(&Sigma[2])],  M[pgm_read_byte(&Sigma[3])]);
+		BLAKE2S_G(V, 2, 6, 10, 14, M[pgm_read_byte(&Sigma[4])],  M[pgm_read_byte(&Sigma[5])]);
+		BLAKE2S_G(V, 3, 7, 11, 15, M[pgm_read_byte(&Sigma[6])],  M[pgm_read_byte(&Sigma[7])]);
+		BLAKE2S_G(V, 0, 5, 10, 15, M[pgm_read_byte(&Sigma[8])],  M[pgm_read_byte(&Sigma[9])]);
+		BLAKE2S_G(V, 1, 6, 11, 12, M[pgm_read_byte(&Sigma[10])], M[pgm_read_byte(&Sigma[11])]);
+		BLAKE2S_G(V, 2, 7,  8, 13, M[pgm_read_byte(&Sigma[12])], M[pgm_read_byte(&Sigma[13])]);
+		BLAKE2S_G(V, 3, 4,  9, 14, M[pgm_read_byte(&Sigma[14])], M[pgm_read_byte(&Sigma[15])]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		Context->State[i] ^= V[i] ^ V[i + 8];
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Start a new hash with the required digest size in bytes.
+ */
+void BLAKE2s_Init(BLAKE2s_ContextType *Context, uint8 Digest_Size)
+{
+	uint8 i;
+
+	if ((Digest_Size == 0) || (Digest_Size > BLAKE2S_MAX_DIGEST_SIZE))
+	{
+		Digest_Size = BLAKE2S_MAX_DIGEST_SIZE;
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		Context->State[i] = g_IV[i];
+	}
+
+	/* Parameter block: digest size, no key, fanout = depth = 1 */
+	Context->State[0] ^= 0x01010000UL | Digest_Size;
+
+	Context->Counter = 0;
+	Context->Buffer_Length = 0;
+	Context->Digest_Size = Digest_Size;
+}
+
+/*
+ * Description:
+ * Hash a block of bytes, a full block is only compressed once more data follows (the last one is final).
+ */
+void BLAKE2s_Update(BLAKE2s_ContextType *Context, const uint8 *Data, uint16 Length)
+{
+	uint16 i;
+
+	for (i = 0; i < Length; i++)
+	{
+		if (Context->Buffer_Length == BLAKE2S_BLOCK_SIZE)
+		{
+			Context->Counter += BLAKE2S_BLOCK_SIZE;
+			BLAKE2s_Compress(Context, FALSE);
+			Context->Buffer_Length = 0;
+		}
+
+		Context->Buffer[Context->Buffer_Length++] = Data[i];
+	}
+}
+
+/*
+ * Description:
+ * Compress the last block and write the digest (Digest_Size bytes).
+ */
+void BLAKE2s_Final(BLAKE2s_ContextType *Context, uint8 *Digest)
+{
+	uint8 i;
+
+	Context->Counter += Context->Buffer_Length;
+
+	/* The last block is padded with zeros */
+	for (i = Context->Buffer_Length; i < BLAKE2S_BLOCK_SIZE; i++)
+	{
+		Context->Buffer[i] = 0;
+	}
+
+	BLAKE2s_Compress(Context, TRUE);
+
+	for (i = 0; i < Context->Digest_Size; i++)
+	{
+		Digest[i] = (uint8)(Context->State[i / 4] >> (8 * (i % 4)));
+	}
+}
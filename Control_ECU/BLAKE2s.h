@@ -0,0 +1,55 @@
+/*****************************************************************************************************************
+ * File Name: BLAKE2s.h
+ * Date: 18/10/2026
+ * Driver: BLAKE2s Hash Utility Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef BLAKE2S_H_
+#define BLAKE2S_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* BLAKE2s (RFC 7693) without key, the digest size is 1 to 32 bytes */
+#define BLAKE2S_BLOCK_SIZE                   64
+#define BLAKE2S_MAX_DIGEST_SIZE              32
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	uint32 State[8];
+	uint32 Counter;                          /* bytes hashed, the messages stay far below 4 GB */
+	uint8 Buffer[BLAKE2S_BLOCK_SIZE];
+	uint8 Buffer_Length;
+	uint8 Digest_Size;
+}BLAKE2s_ContextType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Start a new hash with the required digest size in bytes.
+ */
+void BLAKE2s_Init(BLAKE2s_ContextType *Context, uint8 Digest_Size);
+
+/*
+ * Description:
+ * Hash a block of bytes, a full block is only compressed once more data follows (the last one is final).
+ */
+void BLAKE2s_Update(BLAKE2s_ContextType *Context, const uint8 *Data, uint16 Length);
+
+/*
+ * Description:
+ * Compress the last block and write the digest (Digest_Size bytes).
+ */
+void BLAKE2s_Final(BLAKE2s_ContextType *Context, uint8 *Digest);
+
+#endif /* BLAKE2S_H_ */
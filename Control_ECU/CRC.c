@@ -0,0 +1,42 @@
+/*****************************************************************************************************************
+ * File Name: CRC.c
+ * Date: 18/10/2026
+ * Driver: CRC-8 Utility Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "CRC.h"
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Calculate the CRC-8 of a block of bytes stored in NVM records to detect torn or corrupted writes.
+ */
+uint8 CRC8_Calculate(const uint8 *Data, uint8 Length)
+{
+	uint8 crc = CRC8_INITIAL_VALUE;
+	uint8 i;
+	uint8 bit;
+
+	for (i = 0; i < Length; i++)
+	{
+		crc ^= Data[i];
+
+		/* Shift the eight bits of the byte through the polynomial */
+		for (bit = 0; bit < 8; bit++)
+		{
+			if (crc & 0x80)
+			{
+				crc = (uint8)((crc << 1) ^ CRC8_POLYNOMIAL);
+			}
+			else
+			{
+				crc = (uint8)(crc << 1);
+			}
+		}
+	}
+
+	return crc;
+}
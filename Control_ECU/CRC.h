@@ -0,0 +1,30 @@
+/*****************************************************************************************************************
+ * File Name: CRC.h
+ * Date: 18/10/2026
+ * Driver: CRC-8 Utility Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef CRC_H_
+#define CRC_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* CRC-8 polynomial x^8 + x^2 + x + 1 with a non-zero seed, so an all-zero record never has a zero CRC */
+#define CRC8_POLYNOMIAL                      0x07
+#define CRC8_INITIAL_VALUE                   0xFF
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Calculate the CRC-8 of a block of bytes stored in NVM records to detect torn or corrupted writes.
+ */
+uint8 CRC8_Calculate(const uint8 *Data, uint8 Length);
+
+#endif /* CRC_H_ */
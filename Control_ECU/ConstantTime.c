@@ -0,0 +1,31 @@
+/*****************************************************************************************************************
+ * File Name: ConstantTime.c
+ * Date: 18/10/2026
+ * Driver: Constant-Time Comparison Utility Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "ConstantTime.h"
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return TRUE if the two blocks are equal. Every byte is compared and the result is derived without a branch
+ * on the data, so the time only depends on Length, never on where the blocks differ.
+ */
+boolean ConstantTime_IsEqual(const uint8 *Block_A, const uint8 *Block_B, uint8 Length)
+{
+	/* volatile keeps the compiler from turning the accumulation back into an early exit */
+	volatile uint8 Difference = 0;
+	uint8 i;
+
+	for (i = 0; i < Length; i++)
+	{
+		Difference |= (uint8)(Block_A[i] ^ Block_B[i]);
+	}
+
+	/* 0 - 1 borrows into bit 8 only when no byte differed */
+	return (boolean)(((uint16)Difference - 1U) >> 8) & 1U;
+}
@@ -0,0 +1,23 @@
+/*****************************************************************************************************************
+ * File Name: ConstantTime.h
+ * Date: 18/10/2026
+ * Driver: Constant-Time Comparison Utility Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef CONSTANT_TIME_H_
+#define CONSTANT_TIME_H_
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Return TRUE if the two blocks are equal. Every byte is compared and the result is derived without a branch
+ * on the data, so the time only depends on Length, never on where the blocks differ.
+ */
+boolean ConstantTime_IsEqual(const uint8 *Block_A, const uint8 *Block_B, uint8 Length);
+
+#endif /* CONSTANT_TIME_H_ */
@@ -2,7 +2,7 @@
  * [File]: Control_ECU.c
  * [Date]: 21/8/2023
  * [Objective]: Developing a system to unlock a door using a password - Control ECU.
- * [Drivers]: GPIO - Timer0 - Timer1 - UART - I2C - DC_Motor - External EEPROM - Buzzer
+ * [Drivers]: GPIO - Timer0 - Timer1 - Timer2 - UART - I2C (master and slave) - DC_Motor - External EEPROM - Buzzer
  * [Author]: Youssef Ahmed Zaki
  *************************************************************************************************************************/
 #include <avr/io.h>
@@ -12,6 +12,7 @@
 #include "GPIO.h"
 #include "TIMER0.h"
 #include "TIMER1.h"
+#include "TIMER2.h"
 #include "UART.h"
 #include "I2C.h"
 
@@ -20,12 +21,29 @@
 #include "EEPROM.h"
 #include "DC_Motor.h"
 
+/* Services */
+#include "Tick.h"
+#include "TimerWheel.h"
+#include "Scheduler.h"
+#include "Power.h"
+#include "Profile.h"
+#include "Watchdog.h"
+#include "NVM.h"
+#include "NVM_Layout.h"
+#include "NVM_Mirror.h"
+#include "NVM_Scrub.h"
+#include "Credential.h"
+#include "Lockout.h"
+#include "Supervisor.h"
+#include "ConstantTime.h"
+
 #define HMI_READY                              0x10
 #define CONTROL_READY                          0x20
-#define PASSWORD_SIZE                          5
+#define PASSWORD_SIZE                          CREDENTIAL_PIN_SIZE
 
 #define PASSWORDS_UNMATCHED                    0x30
 #define PASSWORDS_MATCHED                      0x40
+#define STORAGE_FAILURE                        0x70
 
 #define PASS_RECEIVED                          0x06
 #define DISPLAY_ERROR                          0x0C
@@ -33,12 +51,83 @@
 #define OPEN_THE_DOOR                          0x03
 #define CHANGE_PASSWORD                        0x04
 
+/* Sent after CONTROL_READY at boot to tell HMI ECU whether a password survived in the External EEPROM */
+#define PASSWORD_STORED                        0x50
+#define NO_PASSWORD_STORED                     0x60
+#define PASSWORD_LOCKED                        0x80
+
+/* Door timings in msec: the motor runs 15 seconds to open or close the door, which is held open 3 seconds */
+#define DOOR_MOTION_MS                         15000UL
+#define DOOR_HOLD_MS                           3000UL
+
+/* A lockout period lasts 15 seconds, the buzzer sounds 0.5 second every second during the lockout */
+#define LOCKOUT_PERIOD_MS                      15000UL
+#define BUZZER_CADENCE_MS                      500UL
+
+/* Timer1 pre-scaler division while timing the PIN hash */
+#define BENCHMARK_DIVIDER                      8UL
+
+/*
+ * One storage block is scrubbed every 100 msec while the user hasn't chosen an option yet (about 1% of the
+ * time awake), the controller sleeps in between. The current estimates are published at the same rate.
+ */
+#define HOUSEKEEPING_MS                        100UL
+
+/*
+ * Accepted in every step, even while the door moves or the lockout runs:
+ * STATUS_QUERY is answered with DOOR_STATUS then the door state (Supervisor_DoorStateType),
+ * EMERGENCY_STOP stops the door motor at once.
+ */
+#define STATUS_QUERY                           0x90
+#define EMERGENCY_STOP                         0x91
+#define DOOR_STATUS                            0x92
+
+/*
+ * Profiling build: PROFILE_DUMP is answered with the profiling table as text lines (Profile_Dump) between
+ * PROFILE_FRAME_START and PROFILE_FRAME_END, for a terminal on the line. Both ECUs drop the frames received.
+ */
+#define PROFILE_DUMP                           0x93
+#define PROFILE_FRAME_START                    0x95
+#define PROFILE_FRAME_END                      0x96
+
+/*
+ * Sent by HMI ECU at its boot (again until answered): answered in every step with
+ * CONTROL_READY then the password state, the step running is abandoned. HMI ECU says hello after its reset,
+ * and after an exchange timed out (this ECU was reset), so a reset of either ECU resynchronizes the link.
+ */
+#define HMI_HELLO                              0x94
+
+/*
+ * HMI ECU sends every byte of an exchange at once, an exchange waiting longer than this for its next byte is
+ * abandoned (HMI ECU was reset) and the step kept until HMI ECU starts it again or says hello.
+ */
+#define LINK_TIMEOUT_MS                        1000UL
+
+/* Scheduler events */
+#define EVENT_UART_RECEIVED                    0x01
+#define EVENT_DOOR_TIMER                       0x02
+#define EVENT_LOCKOUT_TIMER                    0x03
+#define EVENT_HOUSEKEEPING_TIMER               0x04
+
 /* Control ECU Cases */
 #define RECEIVE_FIRST_PASSWORD                 0x00
 #define RECEIVE_AND_CHECK_CONFIRMED_PASSWORD   0x01
 #define RECEIVING_MAIN_OPTION                  0x02
 #define OPEN_THE_DOOR                          0x03
 #define PASSWORD_ERROR                         0x04
+#define RECEIVING_OPTION_PASSWORD              0x05
+#define DOOR_MOVING                            0x06
+#define LOCKOUT_RUNNING                        0x07
+#define CONTROL_STATES_NUMBER                  8
+
+/* Watchdog checkpoints of the boot steps, the steps above check in with their number (Scheduler_Run) */
+#define BOOT_STORAGE                           0x80
+#define BOOT_LAYOUT                            0x81
+#define BOOT_MIRROR                            0x82
+#define BOOT_CREDENTIAL                        0x83
+#define BOOT_LOCKOUT                           0x84
+#define BOOT_CALIBRATION                       0x85
+#define BOOT_SUPERVISOR                        0x86
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -47,10 +136,44 @@
  ********************************************************************************************************/
 
 uint8 Control_ECU_Sequence = 0;
-uint8 *G_Pass1[PASSWORD_SIZE];
-uint8 *G_Pass2[PASSWORD_SIZE];
-uint8 Counter;
-uint8 G_Timer1_Count = 0;
+uint8 G_Pass1[PASSWORD_SIZE];
+uint8 G_Pass2[PASSWORD_SIZE];
+uint8 G_Option;
+Supervisor_DoorStateType G_Door_State = SUPERVISOR_DOOR_CLOSED;
+
+/*
+ * Longest run in msec of the handling of one event in every step. Saving a password hashes it and writes two
+ * records, checking one hashes it (CREDENTIAL_VERIFY_BUDGET_MS) and may persist a wrong attempt.
+ */
+const uint16 G_Step_Budgets[CONTROL_STATES_NUMBER] =
+{
+	50,                                     /* RECEIVE_FIRST_PASSWORD */
+	CREDENTIAL_VERIFY_BUDGET_MS + 250,      /* RECEIVE_AND_CHECK_CONFIRMED_PASSWORD */
+	50,                                     /* RECEIVING_MAIN_OPTION */
+	50,                                     /* OPEN_THE_DOOR */
+	50,                                     /* PASSWORD_ERROR */
+	CREDENTIAL_VERIFY_BUDGET_MS + 100,      /* RECEIVING_OPTION_PASSWORD */
+	20,                                     /* DOOR_MOVING */
+	50                                      /* LOCKOUT_RUNNING */
+};
+
+/*
+ * Timer0 PWM Mode Configuration:
+ * 1. TCNT0 = 0 -> Starting Value of Timer is Zero.
+ * 2. OCR0 = 0 -> It is based on the Duty_Cycle of the PWM Signal.
+ * 3. Pre-scalar = F_CPU/8 -> To control DC motor using a 3.9 Khz PWM Signal (F_CPU/8/256 at 8 Mhz),
+ *    1 usec timestamp resolution in the profiling build.
+ * 4. Timer0 Mode -> Fast PWM Mode.
+ * Timer0 runs only while the door is open or moves, but all along in the profiling build.
+ */
+const Timer0_ConfigType G_Timer0_Config = {0, 0, TIMER0_PRESCALER(8), TIMER0_Fast_PWM_3};
+
+/* Software timers of the door phases, of the lockout and of the housekeeping, on the timer wheel */
+TimerWheel_TimerType G_Door_Timer;
+TimerWheel_TimerType G_Lockout_Timer;
+TimerWheel_TimerType G_Buzzer_Timer;
+TimerWheel_TimerType G_Housekeeping_Timer;
+boolean G_Buzzer_Sounding = FALSE;
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -60,106 +183,695 @@ uint8 G_Timer1_Count = 0;
 
 /*
  * Description:
- * Function is responsible to be called when Timer1 interrupt occurs to increment the ticks by one.
+ * Function is responsible to be called from the UART interrupt when a byte arrives in an empty buffer.
+ */
+void UartReceive_CallBack(void)
+{
+	Scheduler_Post(EVENT_UART_RECEIVED, 0);
+}
+
+/*
+ * Description:
+ * Function is responsible to be called from the timer wheel at the end of every door phase.
+ */
+void DoorTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_DOOR_TIMER, 0);
+}
+
+/*
+ * Description:
+ * Function is responsible to be called from the timer wheel at the end of every lockout period.
+ */
+void LockoutTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_LOCKOUT_TIMER, 0);
+}
+
+/*
+ * Description:
+ * Function is responsible to be called from the timer wheel every housekeeping period.
  */
-void Timer1_CallBack(void)
+void HousekeepingTimer_CallBack(void)
 {
-	/* Every three seconds, it increments by one */
-	G_Timer1_Count++;
+	Scheduler_Post(EVENT_HOUSEKEEPING_TIMER, 0);
 }
 
 /*
  * Description:
- * Function is responsible for receiving the password from HMI ECU.
+ * Function is responsible to be called from the timer wheel to switch the buzzer on and off during the lockout.
  */
-void ReceivePassword(uint8 *pass)
+void BuzzerTimer_CallBack(void)
 {
+	G_Buzzer_Sounding = !G_Buzzer_Sounding;
+
+	if (G_Buzzer_Sounding)
+	{
+		Buzzer_ON();
+	}
+	else
+	{
+		Buzzer_OFF();
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for receiving the next byte of an exchange with HMI ECU, LINK_TIMEOUT_MS at most
+ * after Start. Returns FALSE on a timeout or a HMI_HELLO (HMI ECU was reset, its next hello is answered).
+ */
+boolean ReceiveLinkByte(uint8 *Byte, Tick_Type Start)
+{
+	Tick_Type Elapsed = Tick_Elapsed(Start);
+
+	/* A bounded wait is no hang */
+	Watchdog_Checkpoint(Control_ECU_Sequence);
+
+	if ((Elapsed >= LINK_TIMEOUT_MS) || !UART_ReceiveByteTimeout(Byte, (uint16)(LINK_TIMEOUT_MS - Elapsed)))
+	{
+		return FALSE;
+	}
+
+	return (*Byte != HMI_HELLO);
+}
+
+/*
+ * Description:
+ * Function is responsible for waiting for the given byte from HMI ECU, the other bytes are dropped.
+ * Returns FALSE if it didn't come within LINK_TIMEOUT_MS (see ReceiveLinkByte).
+ */
+boolean WaitLinkByte(uint8 Expected)
+{
+	Tick_Type Start = Tick_Now();
+	uint8 Byte;
+
+	do
+	{
+		if (!ReceiveLinkByte(&Byte, Start))
+		{
+			return FALSE;
+		}
+	}while (Byte != Expected);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Function is responsible for receiving the password from HMI ECU after its HMI_READY.
+ * Returns FALSE if the exchange was abandoned (see ReceiveLinkByte).
+ */
+boolean ReceivePassword(uint8 *pass)
+{
+	Tick_Type Start;
 	uint8 i;
 
-	/* Coordinate data transmit with another ECU */
-	while (UART_ReceiveByte()!= HMI_READY);
+	/* Coordinate data transmit with another ECU (HMI_READY was already received) */
 	UART_SendByte(CONTROL_READY);
+	Start = Tick_Now();
 
 	/* Receiving the password from the user */
 	for(i = 0; i < PASSWORD_SIZE; i++)
 	{
-		pass[i] = UART_ReceiveByte();
+		if (!ReceiveLinkByte(&pass[i], Start))
+		{
+			return FALSE;
+		}
 	}
 
 	/* Send to HMI ECU that password is successfully received */
 	UART_SendByte(PASS_RECEIVED);
+	return TRUE;
 }
 
 /*
  * Description:
- * Function is responsible for checking the entered password with the one save in External EEPROM.
+ * Function is responsible for checking the entered password with the digest saved in External EEPROM.
+ * Returns STORAGE_FAILURE if the saved password couldn't be read, which is not counted as a wrong attempt.
  */
-uint8 CheckPassword(uint8 *Pass1_Receive, uint8 *Pass2_Receive)
+uint8 CheckPassword(const uint8 *Pass_Receive)
 {
-	uint8 i;
+	boolean Matched;
+	uint8 Result;
+
+	PROFILE_ENTER(PROFILE_CHECK_PASSWORD);
+
+	/* Hash the entered password like the saved one, a missing or corrupted record never matches */
+	if (Credential_Verify(Pass_Receive, &Matched) == ERROR)
+	{
+		Result = STORAGE_FAILURE;
+	}
+	else
+	{
+		Result = Matched ? PASSWORDS_MATCHED : PASSWORDS_UNMATCHED;
+	}
+
+	PROFILE_EXIT(PROFILE_CHECK_PASSWORD);
+	return Result;
+}
+
+/*
+ * Description:
+ * Function is responsible for comparing entered password and confirmed password.
+ * All the digits are compared whatever the first mismatch, the reply time doesn't tell how many were right.
+ */
+uint8 ComparePasswords(const uint8 *Pass1_Receive, const uint8 *Pass2_Receive)
+{
+	return ConstantTime_IsEqual(Pass1_Receive, Pass2_Receive, PASSWORD_SIZE) ? PASSWORDS_MATCHED : PASSWORDS_UNMATCHED;
+}
 
-	/* Read the EEPROM saved password */
-	for (i = 0; i < PASSWORD_SIZE; i++)
+/*
+ * Description:
+ * Function is responsible for saving the password if the entered and confirmed password are matched.
+ * The old password stays valid until the new one is completely written (power-fail-safe update).
+ */
+uint8 SavePassword(uint8 *Pass_Receive)
+{
+	/* Store the Password in the inactive EEPROM slot then commit it */
+	return Credential_Save(Pass_Receive);
+}
+
+/*
+ * Description:
+ * Function is responsible for timing the PIN hash on this part to choose the work factor of the saved passwords.
+ * Timer1 counts at F_CPU/8 in Normal Mode, CREDENTIAL_BENCHMARK_ITERATIONS must take less than one overflow
+ * (65.5 msec at 8 Mhz). A longer benchmark (a slower part) keeps CREDENTIAL_DEFAULT_ITERATIONS, the wrapped
+ * count would choose a work factor far too large.
+ */
+void CalibratePinHash(void)
+{
+	Timer1_ConfigType Timer1_Benchmark_Config = {0, 0xFFFF, TIMER1_PRESCALER(BENCHMARK_DIVIDER), TIMER1_Normal_0};
+	uint16 Counts;
+	boolean Overflowed;
+
+	Timer1_NonPWm_Mode_Init(&Timer1_Benchmark_Config);
+	Credential_Benchmark(CREDENTIAL_BENCHMARK_ITERATIONS);
+	Counts = Timer1_GetCount();
+	Overflowed = Timer1_HasOverflowed();
+	Timer1_DeInit();
+
+	if (!Overflowed)
 	{
-		EEPROM_ReadByte((0x0000 + i), &Pass2_Receive[i]);
-		_delay_ms(10);
+		Credential_Calibrate(((uint32)Counts * BENCHMARK_DIVIDER) / CREDENTIAL_BENCHMARK_ITERATIONS);
 	}
+}
+
+/*
+ * Description:
+ * Function is responsible for verifying one block of the storage and reporting its damage to the supervisor.
+ */
+void ScrubStorage(void)
+{
+	switch (NVM_Scrub_Step())
+	{
+	case NVM_SCRUB_REPAIRED:
+		Supervisor_RecordEvent(SUPERVISOR_EVENT_STORAGE_REPAIRED);
+		break;
+
+	case NVM_SCRUB_CORRUPTED:
+		Supervisor_RecordEvent(SUPERVISOR_EVENT_STORAGE_FAILURE);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for publishing the door state to the supervisor and to the status queries.
+ */
+void SetDoorState(Supervisor_DoorStateType State)
+{
+	G_Door_State = State;
+	Supervisor_SetDoorState(State);
+}
+
+/*
+ * Description:
+ * Function is responsible for opening the door by rotating the DC Motor Clockwise at the speed set by the
+ * supervisor, the door timer events drive the next phases.
+ */
+void StartDoor(void)
+{
+#ifndef PROFILE_ENABLE
+	Timer0_PWM_Mode_Init(&G_Timer0_Config);
+#endif
+
+	SetDoorState(SUPERVISOR_DOOR_OPENING);
+	Supervisor_RecordEvent(SUPERVISOR_EVENT_DOOR_OPENED);
+	DcMotor_Rotate(CW, Supervisor_GetMotorSpeed());
+
+	/* The door is open 15 seconds later */
+	TimerWheel_Start(&G_Door_Timer, DOOR_MOTION_MS, 0, DoorTimer_CallBack);
+	Control_ECU_Sequence = DOOR_MOVING;
+}
+
+/*
+ * Description:
+ * Function is responsible for stopping the motor and returning to the main option.
+ */
+void StopDoor(Supervisor_DoorStateType State)
+{
+	TimerWheel_Stop(&G_Door_Timer);
+	DcMotor_Rotate(STOP, 0);
+#ifndef PROFILE_ENABLE
+	Timer0_DeInit();
+#endif
+
+	SetDoorState(State);
+
+	/* return to receiving the main option from user */
+	Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+}
+
+/*
+ * Description:
+ * Function is responsible for moving the door to its next phase when the door timer expires:
+ * open (15 seconds) -> hold (3 seconds) -> close (15 seconds).
+ */
+void DoorTimerElapsed(void)
+{
+	switch (G_Door_State)
+	{
+	case SUPERVISOR_DOOR_OPENING:
+
+		/* Stop rotating the motor after opening the door and hold it */
+		DcMotor_Rotate(STOP, 0);
+		SetDoorState(SUPERVISOR_DOOR_OPEN);
+		TimerWheel_Start(&G_Door_Timer, DOOR_HOLD_MS, 0, DoorTimer_CallBack);
+		break;
+
+	case SUPERVISOR_DOOR_OPEN:
+
+		/* Close the Door by rotating the DC Motor Anti-Clockwise at the speed set by the supervisor */
+		SetDoorState(SUPERVISOR_DOOR_CLOSING);
+		DcMotor_Rotate(A_CW, Supervisor_GetMotorSpeed());
+		TimerWheel_Start(&G_Door_Timer, DOOR_MOTION_MS, 0, DoorTimer_CallBack);
+		break;
+
+	case SUPERVISOR_DOOR_CLOSING:
+		StopDoor(SUPERVISOR_DOOR_CLOSED);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for telling HMI ECU that the lockout starts, it answers with HMI_READY.
+ */
+void EnterLockout(void)
+{
+	/* Coordinate data transmit with another ECU */
+	UART_SendByte(CONTROL_READY);
+
+	/* Jump to Password Error Step */
+	Control_ECU_Sequence = PASSWORD_ERROR;
+}
+
+/*
+ * Description:
+ * Function is responsible for telling HMI ECU whether a password is stored (at the boot and at every HMI_HELLO):
+ * the step running is abandoned, the door stopped, and the lockout resumed if the lock is locked out.
+ */
+void AnnounceStatus(void)
+{
+	if (Control_ECU_Sequence == DOOR_MOVING)
+	{
+		StopDoor(SUPERVISOR_DOOR_STOPPED);
+	}
+	else if (Control_ECU_Sequence == LOCKOUT_RUNNING)
+	{
+		/* The periods elapsed are persisted, the lockout restarts below with the ones left */
+		TimerWheel_Stop(&G_Lockout_Timer);
+		TimerWheel_Stop(&G_Buzzer_Timer);
+		G_Buzzer_Sounding = FALSE;
+		Buzzer_OFF();
+	}
+
+	/* Send this byte to HMI_ECU to let the HMI ECU sends the password */
+	UART_SendByte(CONTROL_READY);
+
+	/* Resume the lockout if the lock was reset during it, skip password creation if a password is stored */
+	if (Credential_IsStored() && Lockout_IsActive())
+	{
+		UART_SendByte(PASSWORD_LOCKED);
+		EnterLockout();
+	}
+	else if (Credential_IsStored())
+	{
+		UART_SendByte(PASSWORD_STORED);
+		Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+	}
+	else
+	{
+		UART_SendByte(NO_PASSWORD_STORED);
+		Control_ECU_Sequence = RECEIVE_FIRST_PASSWORD;
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for starting the lockout, the lockout timer events count its periods.
+ */
+void StartLockout(void)
+{
+	/* Send to HMI ECU to display error on LCD Screen and the lockout periods left (fewer after a reset) */
+	UART_SendByte(DISPLAY_ERROR);
+	UART_SendByte(Lockout_GetRemainingPeriods());
+
+	SetDoorState(SUPERVISOR_DOOR_LOCKED_OUT);
+	Supervisor_RecordEvent(SUPERVISOR_EVENT_LOCKOUT_STARTED);
 
-	/* Compare entered password with EEPROM saved password */
-	for (i = 0; i < PASSWORD_SIZE; i++)
+	/* Sound the buzzer when three failed attempts of password are entered (unless the supervisor muted it) */
+	if (Supervisor_IsAlarmEnabled())
 	{
-		if (Pass1_Receive[i] != Pass2_Receive[i])
+		TimerWheel_Start(&G_Buzzer_Timer, 1, BUZZER_CADENCE_MS, BuzzerTimer_CallBack);
+	}
+
+	/* wait one minute (4 periods of 15 seconds) */
+	TimerWheel_Start(&G_Lockout_Timer, LOCKOUT_PERIOD_MS, LOCKOUT_PERIOD_MS, LockoutTimer_CallBack);
+	Control_ECU_Sequence = LOCKOUT_RUNNING;
+}
+
+/*
+ * Description:
+ * Function is responsible for persisting every elapsed lockout period and ending the lockout after the last one.
+ */
+void LockoutPeriodElapsed(void)
+{
+	Lockout_RecordPeriodElapsed();
+	Supervisor_RefreshLockout();
+
+	if (Lockout_GetRemainingPeriods() > 0)
+	{
+		return;
+	}
+
+	/* Stop the timers and turn off the buzzer */
+	TimerWheel_Stop(&G_Lockout_Timer);
+	TimerWheel_Stop(&G_Buzzer_Timer);
+	G_Buzzer_Sounding = FALSE;
+	Buzzer_OFF();
+
+	SetDoorState(SUPERVISOR_DOOR_CLOSED);
+	Supervisor_RecordEvent(SUPERVISOR_EVENT_LOCKOUT_ENDED);
+
+	/* return to receiving the main option from user */
+	Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+}
+
+/*
+ * Description:
+ * Function is responsible for checking the option password and taking the action of the selected option
+ * (+ : Open the Door or - : Change Password).
+ */
+void CheckOptionPassword(void)
+{
+	uint8 Pass_Check;
+
+	/* receive the password from HMI ECU */
+	if (!ReceivePassword(G_Pass1))
+	{
+		return;
+	}
+
+	/* Check the received password if it is matched with one saved in the External EEPROM */
+	Pass_Check = CheckPassword(G_Pass1);
+
+	/* Coordinate data transmit with another ECU, the attempt isn't counted if its result can't be shown */
+	UART_SendByte(CONTROL_READY);
+	if (!WaitLinkByte(HMI_READY))
+	{
+		return;
+	}
+
+	if (Pass_Check == PASSWORDS_MATCHED)
+	{
+		/* Forget the previous wrong attempts (a failure only keeps them for the next boot) */
+		Lockout_Clear();
+
+		/* Send to HMI ECU that passwords are matched */
+		UART_SendByte(PASSWORDS_MATCHED);
+
+		/* Jump to open the door step or to Change Password step */
+		Control_ECU_Sequence = (G_Option == '+') ? OPEN_THE_DOOR : RECEIVE_FIRST_PASSWORD;
+	}
+	else if ((Pass_Check == STORAGE_FAILURE) || (Lockout_RecordFailure() == ERROR))
+	{
+		Supervisor_RecordEvent(SUPERVISOR_EVENT_STORAGE_FAILURE);
+
+		/*
+		 * Send to HMI ECU that the saved password couldn't be read or the wrong attempt couldn't be
+		 * persisted (not a wrong attempt, the result is never shown before the attempt is stored)
+		 */
+		UART_SendByte(STORAGE_FAILURE);
+
+		/* Return to take the option again from the user */
+		Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+	}
+	else
+	{
+		Supervisor_RecordEvent(SUPERVISOR_EVENT_WRONG_PASSWORD);
+
+		/* Send to HMI ECU that passwords are un-matched and the wrong attempts left */
+		UART_SendByte(PASSWORDS_UNMATCHED);
+		UART_SendByte(Lockout_GetAttemptsLeft());
+
+		/* Return to take the option again from the user */
+		Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+	}
+
+	/* take an action if the wrong attempts reach 3 attempts */
+	if (Lockout_IsActive())
+	{
+		EnterLockout();
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for taking the action of the current step when HMI ECU is ready.
+ */
+void HmiReady(void)
+{
+	uint8 Check;
+
+	switch(Control_ECU_Sequence)
+	{
+
+	/* Receiving the first password from the user */
+	case RECEIVE_FIRST_PASSWORD:
+
+		/* receive the first password from HMI ECU, then jump to the next step */
+		if (ReceivePassword(G_Pass1))
+		{
+			Control_ECU_Sequence = RECEIVE_AND_CHECK_CONFIRMED_PASSWORD;
+		}
+		break;
+
+		/* Receiving the second password from the user and check if it is matched with the first one */
+	case RECEIVE_AND_CHECK_CONFIRMED_PASSWORD:
+
+		/* receive the confirmed password from HMI ECU */
+		if (!ReceivePassword(G_Pass2))
+		{
+			break;
+		}
+
+		/* Check if the two password are matched or not */
+		Check = ComparePasswords(G_Pass1, G_Pass2);
+
+		/* Coordinate data transmit with another ECU */
+		UART_SendByte(CONTROL_READY);
+		if (!WaitLinkByte(HMI_READY))
+		{
+			break;
+		}
+
+		/* Save Password in the External EEPROM */
+		if ((Check == PASSWORDS_MATCHED) && (SavePassword(G_Pass1) == SUCCESS))
+		{
+			Supervisor_RecordEvent(SUPERVISOR_EVENT_PASSWORD_CHANGED);
+
+			/* Send to HMI ECU that passwords are matched */
+			UART_SendByte(PASSWORDS_MATCHED);
+
+			/* Jump to the next step */
+			Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
+		}
+		else if (Check == PASSWORDS_MATCHED)
+		{
+			Supervisor_RecordEvent(SUPERVISOR_EVENT_STORAGE_FAILURE);
+
+			/* Send to HMI ECU that the password couldn't be saved */
+			UART_SendByte(STORAGE_FAILURE);
+
+			/* return to first step */
+			Control_ECU_Sequence = RECEIVE_FIRST_PASSWORD;
+		}
+		else
+		{
+			/* Send to HMI ECU that passwords are un-matched */
+			UART_SendByte(PASSWORDS_UNMATCHED);
+
+			/* return to first step */
+			Control_ECU_Sequence = RECEIVE_FIRST_PASSWORD;
+		}
+		break;
+
+		/* Receiving the user selection from the main options */
+	case RECEIVING_MAIN_OPTION:
+
+		/* The user's timing (8 usec resolution) is the salt entropy of the next password */
+		Credential_AddEntropy((uint8)Tick_NowCounts());
+
+		/* Coordinate data transmit with another ECU */
+		UART_SendByte(CONTROL_READY);
+
+		/* Receive the result of option selection by user (+ : Open the Door or - : Change Password) */
+		if (ReceiveLinkByte(&G_Option, Tick_Now()))
+		{
+			Control_ECU_Sequence = RECEIVING_OPTION_PASSWORD;
+		}
+		break;
+
+		/* Receiving the password of the selected option and take action according to this selection */
+	case RECEIVING_OPTION_PASSWORD:
+		CheckOptionPassword();
+		break;
+
+		/* Open the door by rotating the motor cw for 15 seconds then A_cw for 15 seconds to open/close the door */
+	case OPEN_THE_DOOR:
+
+		/* Coordinate data transmit with another ECU */
+		UART_SendByte(CONTROL_READY);
+
+		/* Wait until HMI ECU sends Open the Door */
+		if (WaitLinkByte(OPEN_THE_DOOR))
 		{
-			/* Send to HMI ECU that two passwords are un-matched */
-			return PASSWORDS_UNMATCHED;
+			StartDoor();
 		}
+		break;
+
+	case PASSWORD_ERROR:
+		StartLockout();
+		break;
+
+	default:
+		/* The door moves or the lockout runs, HMI ECU polls the status meanwhile */
+		break;
 	}
-	return PASSWORDS_MATCHED;
 }
 
 /*
  * Description:
- * Function is responsible for comparing entered password and confirmed password.
+ * Function is responsible for handling one byte received from HMI ECU.
  */
-uint8 ComparePasswords(uint8 *Pass1_Receive, uint8 *Pass2_Receive)
+void HandleByte(uint8 Byte)
 {
-	uint8 i;
-
-	/* Receive the Confirmed Password */
-	for (i = 0; i < PASSWORD_SIZE; i++)
+	switch (Byte)
 	{
-		if (Pass1_Receive[i] != Pass2_Receive[i])
+	case STATUS_QUERY:
+		UART_SendByte(DOOR_STATUS);
+		UART_SendByte((uint8)G_Door_State);
+		break;
+
+	case EMERGENCY_STOP:
+		if (Control_ECU_Sequence == DOOR_MOVING)
 		{
-			/* Send to HMI ECU that two passwords are un-matched */
-			return PASSWORDS_UNMATCHED;
+			StopDoor(SUPERVISOR_DOOR_STOPPED);
+			Supervisor_RecordEvent(SUPERVISOR_EVENT_EMERGENCY_STOP);
 		}
+		break;
+
+	case HMI_READY:
+		HmiReady();
+		break;
+
+	case HMI_HELLO:
+		AnnounceStatus();
+		break;
+
+#ifdef PROFILE_ENABLE
+	case PROFILE_DUMP:
+		UART_SendByte(PROFILE_FRAME_START);
+		Profile_Dump(UART_SendByte);
+		UART_SendByte(PROFILE_FRAME_END);
+		break;
+#endif
+
+	default:
+		/* Not expected in this step */
+		break;
 	}
-	/* Send to HMI ECU that two passwords are matched */
-	return PASSWORDS_MATCHED;
 }
 
 /*
  * Description:
- * Function is responsible for saving the password if the entered and confirmed password are matched.
+ * Function is responsible for scrubbing one storage block while the user hasn't chosen an option yet and
+ * publishing the current estimates and the latencies.
  */
-void SavePassword(uint8 *Pass_Receive)
+void Housekeeping(void)
 {
-	uint8 i;
+	if (Control_ECU_Sequence == RECEIVING_MAIN_OPTION)
+	{
+		ScrubStorage();
+	}
+
+	Supervisor_SetCurrents(Power_GetCurrent(RECEIVING_MAIN_OPTION), Power_GetCurrent(DOOR_MOVING),
+			Power_GetCurrent(LOCKOUT_RUNNING));
+	Supervisor_SetLatencies(Scheduler_GetStatistics());
+}
 
-	/* Store the Password in EEPROM */
-	for (i = 0; i < PASSWORD_SIZE; i++)
+/*
+ * Description:
+ * Function is responsible for handling the scheduler events, it returns as soon as the event is handled.
+ */
+void ControlTask(const Scheduler_EventType *Event)
+{
+	switch (Event -> Type)
 	{
-		EEPROM_WriteByte((0x0000 + i), Pass_Receive[i]);
-		_delay_ms(10);
+	case EVENT_UART_RECEIVED:
+		while (UART_IsByteReceived())
+		{
+			HandleByte(UART_ReceiveByte());
+		}
+		break;
+
+	case EVENT_DOOR_TIMER:
+		if (Control_ECU_Sequence == DOOR_MOVING)
+		{
+			DoorTimerElapsed();
+		}
+		break;
+
+	case EVENT_LOCKOUT_TIMER:
+		if (Control_ECU_Sequence == LOCKOUT_RUNNING)
+		{
+			LockoutPeriodElapsed();
+		}
+		break;
+
+	case EVENT_HOUSEKEEPING_TIMER:
+		Housekeeping();
+		break;
+
+	default:
+		break;
 	}
+
+	/* The next event is checked against the budget of the step reached, and the time until then charged to it */
+	Scheduler_SetState(Control_ECU_Sequence);
 }
 
 int main(void)
 {
-	uint8 Check;
-	uint8 Pass_Check;
-	uint8 Result;
-	uint8 i = 0;
+	Tick_Type Boot_Start;
+	Tick_Type Boot_Time;
 
 	/*********************************************************************************************************
 	 *                                                                                                       *
@@ -167,24 +879,6 @@ int main(void)
 	 *                                                                                                       *
 	 *********************************************************************************************************/
 
-	/*
-	 * Timer0 PWM Mode Configuration:
-	 * 1. TCNT0 = 0 -> Starting Value of Timer is Zero.
-	 * 2. OCR0 = 0 -> It is based on the Duty_Cycle of the PWM Signal.
-	 * 3. Pre-scalar = F_CPU/8 -> To control DC motor using 500Hz PWM Signal.
-	 * 4. Timer0 Mode -> Fast PWM Mode.
-	 */
-	Timer0_ConfigType Timer0_Config = {0, 0, TIMER0_Prescaler_8, TIMER0_Fast_PWM_3};
-
-	/*
-	 * Timer1 Normal Mode Configuration:
-	 * 1. TCNT1 = 0 -> Starting Value of Timer is Zero.
-	 * 2. OCR1A = 24000 -> Every 24000 ticks, the timer counts three seconds.
-	 * 3. Pre-scalar = F_CPU/1024 -> (Tick time = 0.125 msec, so (Timer Time / Tick Time = No. of ticks)
-	 * 4. Timer1 Mode -> CTC Mode.
-	 */
-	Timer1_ConfigType Timer1_Config = {0, 24000, TIMER1_Prescaler_1024, TIMER1_CTC_4};
-
 	/*
 	 * UART Configuration:
 	 * 1. UART Mode -> Asynchronous Mode.
@@ -197,11 +891,11 @@ int main(void)
 
 	/*
 	 * Description:
-	 * 1. Set 0x01 as a device address in case of device to be a slave device.
-	 * 2. let Bit Rate: 400.000 kbps by giving the TWBR register value = 2 according to I2C Bit rate formula.
-	 * 3. Set the pre-scaler to be one = F_CPU
+	 * 1. Set 0x01 as a device address, the building supervisor reads the Supervisor register map at it.
+	 * 2. Bit Rate: TWI_SCL_FREQUENCY (400 kbps), TWBR = 2 at F_CPU = 8Mhz derived at compile time.
+	 * 3. Pre-scaler: the smallest one reaching the required bit rate (one = F_CPU).
 	 */
-	TWI_ConfigType TWI_Config = {1, 2, Prescaler_1};
+	TWI_ConfigType TWI_Config = {1, TWI_BIT_RATE_VALUE, TWI_PRESCALER_SELECT};
 
 	/*********************************************************************************************************
 	 *                                                                                                       *
@@ -209,8 +903,22 @@ int main(void)
 	 *                                                                                                       *
 	 *********************************************************************************************************/
 
+	/* A hang of any step below resets the controller within WATCHDOG_PERIOD, the stuck step is kept */
+	Watchdog_Init();
+
 	/* MCAL Drivers Initialization */
 	UART_Init(&UART_Config);
+
+#ifdef PROFILE_ENABLE
+	/*
+	 * Profiling build: the durations are measured with the Timer0 timestamp (1 usec), Timer0 runs from now on
+	 * (the motor pins are low while stopped)
+	 */
+	Timer0_PWM_Mode_Init(&G_Timer0_Config);
+	Timer0_StartTimestamp();
+	Profile_Init(Timer0_GetTimestamp, 0);
+	UART_SetIgnoredFrame(PROFILE_FRAME_START, PROFILE_FRAME_END);
+#endif
 	TWI_Init(&TWI_Config);
 
 	/* HAL Drivers initialization */
@@ -220,229 +928,94 @@ int main(void)
 	/* Global Interrupt Enable bit (I-bit) Activation to activate the all interrupts */
 	SREG |= (1<<7);
 
-	/* Send this byte to HMI_ECU to let the HMI ECU sends the password */
-	UART_SendByte(CONTROL_READY);
-
-	/*********************************************************************************************************
-	 *                                                                                                       *
-	 *                                            * Control Application Sequence *                           *
-	 *                                                                                                       *
-	 *********************************************************************************************************/
-
-	while (1)
-	{
-		switch(Control_ECU_Sequence)
-		{
-
-		/* Receiving the first password from the user */
-		case RECEIVE_FIRST_PASSWORD:
-
-			/* receive the first password from HMI ECU */
-			ReceivePassword(G_Pass1);
+	/* 1 msec time base of every timing below (Timer2), it drives the software timers too */
+	Tick_Init();
+	TimerWheel_Init();
+	Boot_Start = Tick_Now();
 
-			/* Jump to the next step */
-			Control_ECU_Sequence++;
-			break;
-
-			/* Receiving the second password from the user and check if it is matched with the first one */
-		case RECEIVE_AND_CHECK_CONFIRMED_PASSWORD:
-
-			/* receive the confirmed password from HMI ECU */
-			ReceivePassword(G_Pass2);
-
-			/* Check if the two password are matched or not */
-			Check = ComparePasswords(G_Pass1, G_Pass2);
-
-			/* Coordinate data transmit with another ECU */
-			UART_SendByte(CONTROL_READY);
-			while (UART_ReceiveByte()!= HMI_READY);
-
-			if (Check == PASSWORDS_MATCHED)
-			{
-				/* Send to HMI ECU that passwords are matched */
-				UART_SendByte(PASSWORDS_MATCHED);
-
-				/* Save Password in the External EEPROM */
-				SavePassword(G_Pass1);
-
-				/* Jump to the next step */
-				Control_ECU_Sequence++;
-			}
-			else
-			{
-				/* Send to HMI ECU that passwords are un-matched */
-				UART_SendByte(PASSWORDS_UNMATCHED);
-
-				/* return to first step */
-				Control_ECU_Sequence = RECEIVE_FIRST_PASSWORD;
-			}
-			break;
-
-			/* Receiving the user selection from the main options and take action according to this selection */
-		case RECEIVING_MAIN_OPTION:
-
-			/* Coordinate data transmit with another ECU */
-			while (UART_ReceiveByte()!= HMI_READY);
-			UART_SendByte(CONTROL_READY);
-
-			/* Receive the result of option selection by user (+ : Open the Door or - : Change Password) */
-			Result = UART_ReceiveByte();
-
-			/* Check if the password matched or not and send the result to HMI ECU */
-			if ( Result == '+')
-			{
-				/* receive the first password from HMI ECU */
-				ReceivePassword(G_Pass1);
-
-				/* Check the received password if it is matched with one saved in the External EEPROM */
-				Pass_Check = CheckPassword(G_Pass1, G_Pass2);
-
-				/* Coordinate data transmit with another ECU */
-				UART_SendByte(CONTROL_READY);
-				while (UART_ReceiveByte()!= HMI_READY);
-
-				if (Pass_Check == PASSWORDS_MATCHED)
-				{
-					/* Send to HMI ECU that passwords are matched */
-					UART_SendByte(PASSWORDS_MATCHED);
-
-					/* Jump to open the door step */
-					Control_ECU_Sequence = OPEN_THE_DOOR;
-				}
-				else
-				{
-					/* Send to HMI ECU that passwords are un-matched */
-					UART_SendByte(PASSWORDS_UNMATCHED);
-
-					/* increment of the wrong attempts */
-					i++;
-
-					/* Stay at this step to take the password again from the user */
-					Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
-				}
-			}
-			else
-			{
-				/* receive the first password from HMI ECU */
-				ReceivePassword(G_Pass1);
-
-				/* Check the received password if it is matched with one saved in EEPROM */
-				Pass_Check = CheckPassword(G_Pass1, G_Pass2);
-
-				/* Coordinate data transmit with another ECU */
-				UART_SendByte(CONTROL_READY);
-				while (UART_ReceiveByte()!= HMI_READY);
-
-				if (Pass_Check == PASSWORDS_MATCHED)
-				{
-					/* Send to HMI ECU that passwords are matched */
-					UART_SendByte(PASSWORDS_MATCHED);
-
-					/* Jump to Change Password step */
-					Control_ECU_Sequence = RECEIVE_FIRST_PASSWORD;
-				}
-				else
-				{
-					/* Send to HMI ECU that passwords are un-matched */
-					UART_SendByte(PASSWORDS_UNMATCHED);
-
-					/* increment of the wrong attempts */
-					i++;
-
-					/* Stay at this step to take the password again from the user */
-					Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
-				}
-			}
-
-			/* take an action if the wrong attempts reach 3 attempts */
-			if (i == 3)
-			{
-				/* Jump to Password Error Step */
-				Control_ECU_Sequence = PASSWORD_ERROR;
-				i = 0;
-			}
-			break;
-
-			/* Open the door by rotating the motor cw for 15 seconds then A_cw for 15 seconds to open/close the door */
-		case OPEN_THE_DOOR:
-
-			/* Coordinate data transmit with another ECU */
-			while (UART_ReceiveByte()!= HMI_READY);
-			UART_SendByte(CONTROL_READY);
-
-			/* Wait until HMI ECU sends Open the Door */
-			while (UART_ReceiveByte() != OPEN_THE_DOOR);
-
-			/* Start Timers */
-			Timer0_PWM_Mode_Init(&Timer0_Config);
-			Timer1_NonPWm_Mode_Init(&Timer1_Config);
-			Timer1_SetCallBack(Timer1_CallBack);
-
-			/* Open the Door by rotating the DC Motor Clockwise at max speed */
-			DcMotor_Rotate(CW, 100);
-
-			/* Wait 15 seconds until the door is open (3 seconds * 5 ticks )*/
-			while (G_Timer1_Count < 5);
-
-			/* Start from zero again */
-			G_Timer1_Count = 0;
-
-			/* Stop rotating the motor after opening the door */
-			DcMotor_Rotate(STOP, 0);
-
-			/* Wait three seconds (holding the door)*/
-			while (G_Timer1_Count < 1);
-
-			/* Start from zero again */
-			G_Timer1_Count = 0;
+	/*
+	 * Every failed attempt below checks in again: a storage that keeps failing is retried forever as before,
+	 * only a call that never returns resets the controller.
+	 */
 
-			/* Close the Door by rotating the DC Motor Anti-Clockwise at max speed */
-			DcMotor_Rotate(A_CW, 100);
+	/* Storage backend selected by NVM_BACKEND (24Cxx EEPROM, FRAM or internal EEPROM) */
+	Watchdog_Checkpoint(BOOT_STORAGE);
+	NVM_Init();
 
-			/* Wait 15 seconds until door is closed (3 seconds * 5 ticks ) */
-			while (G_Timer1_Count < 5);
+	/* Fetch every record needed before the first keypress with one sequential read of the boot region */
+	while (NVM_BootCache_Load(NVM_BOOT_SIZE) == ERROR)
+	{
+		Watchdog_Checkpoint(BOOT_STORAGE);
+	}
 
-			/* Stop rotating the motor after closing the door */
-			DcMotor_Rotate(STOP, 0);
+	/* Upgrade the data written by an older firmware to the current layout before anyone reads it */
+	do
+	{
+		Watchdog_Checkpoint(BOOT_LAYOUT);
+	}while (NVM_Layout_Init() == ERROR);
 
-			/* Stop the timers */
-			G_Timer1_Count = 0;
-			Timer1_DeInit();
-			Timer0_DeInit();
+	/* Check the internal EEPROM copy of the hot records, after this the password reads skip the I2C bus */
+	do
+	{
+		Watchdog_Checkpoint(BOOT_MIRROR);
+	}while (NVM_Mirror_Init() == ERROR);
 
-			/* return to receiving the main option from user */
-			Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
-			break;
+	/*
+	 * Recover the last committed password from the External EEPROM (at most two block reads).
+	 * The lock can't work without its storage, so keep trying (every failure recovers the bus).
+	 */
+	do
+	{
+		Watchdog_Checkpoint(BOOT_CREDENTIAL);
+	}while (Credential_Init() == ERROR);
 
-		case PASSWORD_ERROR:
+	/* Recover the failed attempts, a reset doesn't give the user three new attempts */
+	do
+	{
+		Watchdog_Checkpoint(BOOT_LOCKOUT);
+	}while (Lockout_Init() == ERROR);
 
-			/* Coordinate data transmit with another ECU */
-			UART_SendByte(CONTROL_READY);
-			while (UART_ReceiveByte()!= HMI_READY);
+	/* The boot is over, the next reads must see the stored bytes */
+	NVM_BootCache_Release();
+	Boot_Time = Tick_Elapsed(Boot_Start);
 
-			/* Send to HMI ECU to display error on LCD Screen */
-			UART_SendByte(DISPLAY_ERROR);
+	/* Derive the PIN hash work factor from its measured time, a verification stays in its latency budget */
+	Watchdog_Checkpoint(BOOT_CALIBRATION);
+	CalibratePinHash();
 
-			/* Start the timer */
-			Timer1_NonPWm_Mode_Init(&Timer1_Config);
-			Timer1_SetCallBack(Timer1_CallBack);
+	/* Answer the building supervisor from the TWI interrupt, the sequence below never polls it */
+	Watchdog_Checkpoint(BOOT_SUPERVISOR);
+	Supervisor_Init();
+	Supervisor_SetBootTime((Boot_Time > 0xFFFF) ? 0xFFFF : (uint16)Boot_Time);
 
-			/* Turn on the buzzer when three failed attempts of password are entered */
-			Buzzer_ON();
+	/* Report the step stuck before the last watchdog reset */
+	Supervisor_SetWatchdog(Watchdog_GetRecord() -> Resets, Watchdog_GetRecord() -> Stage);
+	if (Watchdog_WasReset())
+	{
+		Supervisor_RecordEvent(SUPERVISOR_EVENT_WATCHDOG_RESET);
+	}
 
-			/* wait one minute (60 seconds = 3 seconds * 20 ticks ) */
-			while (G_Timer1_Count < 20);
+	/* Every step below runs from the events of the UART and of the software timers, sleeping in between */
+	Power_Init();
+	Scheduler_Init();
+	Scheduler_AddTask(ControlTask);
+	Scheduler_SetBudgets(G_Step_Budgets, CONTROL_STATES_NUMBER);
+	UART_SetCallBack(UartReceive_CallBack);
+	TimerWheel_Start(&G_Housekeeping_Timer, HOUSEKEEPING_MS, HOUSEKEEPING_MS, HousekeepingTimer_CallBack);
 
-			/* Turn off the buzzer */
-			Buzzer_OFF();
+	/* The hellos of HMI ECU received during the boot are answered once, here (a running HMI ECU drops it) */
+	while (UART_IsByteReceived())
+	{
+		UART_ReceiveByte();
+	}
+	AnnounceStatus();
 
-			/* Stop the timer */
-			G_Timer1_Count = 0;
-			Timer1_DeInit();
+	/*********************************************************************************************************
+	 *                                                                                                       *
+	 *                                            * Control Application Sequence *                           *
+	 *                                                                                                       *
+	 *********************************************************************************************************/
 
-			/* return to receiving the main option from user */
-			Control_ECU_Sequence = RECEIVING_MAIN_OPTION;
-			break;
-		}
-	}
+	Scheduler_SetState(Control_ECU_Sequence);
+	Scheduler_Run();
 }
@@ -0,0 +1,458 @@
+/*****************************************************************************************************************
+ * File Name: Credential.c
+ * Date: 18/10/2026
+ * Driver: Power-Fail-Safe Credential Storage Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "EEPROM.h"
+#include "NVM.h"
+#include "NVM_Mirror.h"
+#include "CRC.h"
+#include "BLAKE2s.h"
+#include "ConstantTime.h"
+#include "Credential.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Index of the slot holding the newest committed record (0 = slot A, 1 = slot B) */
+static uint8 g_ActiveSlot = CREDENTIAL_NO_SLOT;
+
+/* Sequence number of the active record, the next record takes the following number */
+static uint8 g_ActiveSequence = 0;
+
+/* Index of the newest slot holding a PIN in clear (layouts 1 to 4) */
+static uint8 g_LegacySlot = CREDENTIAL_NO_SLOT;
+
+static const NVM_AddressType g_SlotAddress[2] = {CREDENTIAL_SLOT_A_ADDRESS, CREDENTIAL_SLOT_B_ADDRESS};
+
+/* Work factor of the next saved password and the measured cost of one of its iterations */
+static uint16 g_Iterations = CREDENTIAL_DEFAULT_ITERATIONS;
+static uint32 g_IterationCycles = 0;
+
+/* Entropy pool of the salt */
+static uint8 g_Entropy[CREDENTIAL_SALT_SIZE];
+static uint8 g_EntropyIndex = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Check that the slot was committed with the given marker and its contents match the stored CRC.
+ */
+static boolean Credential_IsSlotValid(const uint8 *Slot, uint8 Marker)
+{
+	if (Slot[CREDENTIAL_COMMIT_INDEX] != Marker)
+	{
+		return FALSE;
+	}
+
+	return (CRC8_Calculate(Slot, CREDENTIAL_CRC_INDEX) == Slot[CREDENTIAL_CRC_INDEX]);
+}
+
+/*
+ * Description:
+ * Select the newest of two valid slots (sequence numbers are compared modulo 256).
+ */
+static uint8 Credential_SelectSlot(const uint8 *Slot_A, boolean Valid_A, const uint8 *Slot_B, boolean Valid_B)
+{
+	if (Valid_A && Valid_B)
+	{
+		return ((uint8)(Slot_B[CREDENTIAL_SEQUENCE_INDEX] - Slot_A[CREDENTIAL_SEQUENCE_INDEX]) < 0x80) ? 1 : 0;
+	}
+
+	if (Valid_A)
+	{
+		return 0;
+	}
+
+	if (Valid_B)
+	{
+		return 1;
+	}
+
+	return CREDENTIAL_NO_SLOT;
+}
+
+/*
+ * Description:
+ * Salted and iterated digest of a PIN, every iteration is one BLAKE2s compression:
+ * State(0) = 0, State(i) = BLAKE2s-256(State(i - 1) || Salt || PIN), Digest = first bytes of State(Iterations)
+ */
+static void Credential_Digest(const uint8 *Pin, const uint8 *Salt, uint16 Iterations, uint8 *Digest)
+{
+	BLAKE2s_ContextType Context;
+	uint8 State[BLAKE2S_MAX_DIGEST_SIZE];
+	uint16 n;
+	uint8 i;
+
+	for (i = 0; i < BLAKE2S_MAX_DIGEST_SIZE; i++)
+	{
+		State[i] = 0;
+	}
+
+	for (n = 0; n < Iterations; n++)
+	{
+		BLAKE2s_Init(&Context, BLAKE2S_MAX_DIGEST_SIZE);
+		BLAKE2s_Update(&Context, State, BLAKE2S_MAX_DIGEST_SIZE);
+		BLAKE2s_Update(&Context, Salt, CREDENTIAL_SALT_SIZE);
+		BLAKE2s_Update(&Context, Pin, CREDENTIAL_PIN_SIZE);
+		BLAKE2s_Final(&Context, State);
+	}
+
+	for (i = 0; i < CREDENTIAL_DIGEST_SIZE; i++)
+	{
+		Digest[i] = State[i];
+	}
+}
+
+/*
+ * Description:
+ * Derive a new salt from the entropy pool and the sequence number, so two records never share a salt.
+ */
+static void Credential_NewSalt(uint8 Sequence, uint8 *Salt)
+{
+	BLAKE2s_ContextType Context;
+
+	BLAKE2s_Init(&Context, CREDENTIAL_SALT_SIZE);
+	BLAKE2s_Update(&Context, g_Entropy, CREDENTIAL_SALT_SIZE);
+	BLAKE2s_Update(&Context, &Sequence, 1);
+	BLAKE2s_Final(&Context, Salt);
+
+	/* The next salt depends on this one even if no entropy is added meanwhile */
+	BLAKE2s_Init(&Context, CREDENTIAL_SALT_SIZE);
+	BLAKE2s_Update(&Context, g_Entropy, CREDENTIAL_SALT_SIZE);
+	BLAKE2s_Update(&Context, Salt, CREDENTIAL_SALT_SIZE);
+	BLAKE2s_Final(&Context, g_Entropy);
+}
+
+/*
+ * Description:
+ * Erase a slot with one page write.
+ */
+static uint8 Credential_WipeSlot(uint8 Slot_Index)
+{
+	uint8 Slot[CREDENTIAL_SLOT_SIZE];
+	uint8 i;
+
+	for (i = 0; i < CREDENTIAL_SLOT_SIZE; i++)
+	{
+		Slot[i] = 0xFF;
+	}
+
+	if (NVM_Mirror_WriteBlock(g_SlotAddress[Slot_Index], Slot, CREDENTIAL_SLOT_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Mirror_Sync();
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Boot recovery: read the two slots (two block reads) and select the committed slot with a valid CRC and
+ * the newest sequence number. A half written slot is ignored, so the previous password stays usable.
+ * Returns ERROR only if the EEPROM could not be read.
+ */
+uint8 Credential_Init(void)
+{
+	uint8 Slot_A[CREDENTIAL_SLOT_SIZE];
+	uint8 Slot_B[CREDENTIAL_SLOT_SIZE];
+
+	g_ActiveSlot = CREDENTIAL_NO_SLOT;
+	g_LegacySlot = CREDENTIAL_NO_SLOT;
+	g_ActiveSequence = 0;
+
+	if ((NVM_Mirror_ReadBlock(CREDENTIAL_SLOT_A_ADDRESS, Slot_A, CREDENTIAL_SLOT_SIZE) == ERROR) ||
+		(NVM_Mirror_ReadBlock(CREDENTIAL_SLOT_B_ADDRESS, Slot_B, CREDENTIAL_SLOT_SIZE) == ERROR))
+	{
+		return ERROR;
+	}
+
+	g_ActiveSlot = Credential_SelectSlot(Slot_A, Credential_IsSlotValid(Slot_A, CREDENTIAL_COMMITTED),
+										 Slot_B, Credential_IsSlotValid(Slot_B, CREDENTIAL_COMMITTED));
+	g_LegacySlot = Credential_SelectSlot(Slot_A, Credential_IsSlotValid(Slot_A, CREDENTIAL_PIN_COMMITTED),
+										 Slot_B, Credential_IsSlotValid(Slot_B, CREDENTIAL_PIN_COMMITTED));
+
+	if (g_ActiveSlot != CREDENTIAL_NO_SLOT)
+	{
+		g_ActiveSequence = (g_ActiveSlot == 0) ? Slot_A[CREDENTIAL_SEQUENCE_INDEX] : Slot_B[CREDENTIAL_SEQUENCE_INDEX];
+	}
+	else if (g_LegacySlot != CREDENTIAL_NO_SLOT)
+	{
+		/* The digest of the clear PIN follows it */
+		g_ActiveSequence = (g_LegacySlot == 0) ? Slot_A[CREDENTIAL_SEQUENCE_INDEX] : Slot_B[CREDENTIAL_SEQUENCE_INDEX];
+	}
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Return TRUE if a committed password was found by Credential_Init or stored by Credential_Save.
+ */
+boolean Credential_IsStored(void)
+{
+	return (g_ActiveSlot != CREDENTIAL_NO_SLOT);
+}
+
+/*
+ * Description:
+ * Return TRUE if a committed PIN of layouts 1 to 4 (stored in clear) was found by Credential_Init.
+ */
+boolean Credential_IsLegacyStored(void)
+{
+	return (g_LegacySlot != CREDENTIAL_NO_SLOT);
+}
+
+/*
+ * Description:
+ * Hash the entered PIN with the salt and the work factor of the active slot and compare it with its digest.
+ * Returns ERROR if there is no stored password, the EEPROM access failed or the external record is corrupted
+ * (a corrupted internal copy falls back to the external one and invalidates the mirror).
+ */
+uint8 Credential_Verify(const uint8 *Pin, boolean *Matched)
+{
+	uint8 Slot[CREDENTIAL_SLOT_SIZE];
+	uint8 Digest[CREDENTIAL_DIGEST_SIZE];
+	uint16 Iterations;
+
+	*Matched = FALSE;
+
+	if (g_ActiveSlot == CREDENTIAL_NO_SLOT)
+	{
+		return ERROR;
+	}
+
+	if (NVM_Mirror_ReadBlock(g_SlotAddress[g_ActiveSlot], Slot, CREDENTIAL_SLOT_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	if (!Credential_IsSlotValid(Slot, CREDENTIAL_COMMITTED))
+	{
+		/* The copy read may be the internal one, the external memory stays the authoritative copy */
+		if ((NVM_Mirror_GetState() != NVM_MIRROR_CONSISTENT) ||
+			(NVM_ReadBlock(g_SlotAddress[g_ActiveSlot], Slot, CREDENTIAL_SLOT_SIZE) == ERROR) ||
+			!Credential_IsSlotValid(Slot, CREDENTIAL_COMMITTED))
+		{
+			return ERROR;
+		}
+
+		/* Only the internal copy is damaged: the mirror is copied again at the next boot */
+		NVM_Mirror_Invalidate();
+	}
+
+	/*
+	 * The work factor of the record, not the current one, a record calibrated on another part stays usable.
+	 * It is clamped to CREDENTIAL_MAX_ITERATIONS_FACTOR times the current one, a damaged one doesn't match.
+	 */
+	Iterations = (uint16)Slot[CREDENTIAL_ITERATIONS_INDEX] | ((uint16)Slot[CREDENTIAL_ITERATIONS_INDEX + 1] << 8);
+	if (Iterations < CREDENTIAL_MIN_ITERATIONS)
+	{
+		Iterations = CREDENTIAL_MIN_ITERATIONS;
+	}
+	else if (Iterations > ((uint32)g_Iterations * CREDENTIAL_MAX_ITERATIONS_FACTOR))
+	{
+		Iterations = (uint16)((uint32)g_Iterations * CREDENTIAL_MAX_ITERATIONS_FACTOR);
+	}
+
+	Credential_Digest(Pin, &Slot[CREDENTIAL_SALT_INDEX], Iterations, Digest);
+
+	*Matched = ConstantTime_IsEqual(Digest, &Slot[CREDENTIAL_DIGEST_INDEX], CREDENTIAL_DIGEST_SIZE);
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Store the digest of a new PIN into the inactive slot: one page write with the commit marker left erased,
+ * then the commit marker alone. The new record replaces the old one only once the commit marker is written.
+ */
+uint8 Credential_Save(const uint8 *Pin)
+{
+	uint8 Slot[CREDENTIAL_SLOT_SIZE];
+	uint8 Busy_Slot;
+	uint8 Target_Slot;
+	uint8 i;
+
+	/*
+	 * Never overwrite the active record, nor a clear PIN not yet replaced by its digest. The first record goes
+	 * to slot B, slot A overlaps the raw PIN of layout version 0 which must stay readable until the imported
+	 * record commits.
+	 */
+	Busy_Slot = (g_ActiveSlot != CREDENTIAL_NO_SLOT) ? g_ActiveSlot : g_LegacySlot;
+	Target_Slot = (Busy_Slot == 1) ? 0 : 1;
+
+	for (i = 0; i < CREDENTIAL_SLOT_SIZE; i++)
+	{
+		Slot[i] = 0xFF;
+	}
+
+	Slot[CREDENTIAL_SEQUENCE_INDEX] = (uint8)(g_ActiveSequence + 1);
+	Credential_NewSalt(Slot[CREDENTIAL_SEQUENCE_INDEX], &Slot[CREDENTIAL_SALT_INDEX]);
+	Slot[CREDENTIAL_ITERATIONS_INDEX] = (uint8)g_Iterations;
+	Slot[CREDENTIAL_ITERATIONS_INDEX + 1] = (uint8)(g_Iterations >> 8);
+	Credential_Digest(Pin, &Slot[CREDENTIAL_SALT_INDEX], g_Iterations, &Slot[CREDENTIAL_DIGEST_INDEX]);
+	Slot[CREDENTIAL_CRC_INDEX] = CRC8_Calculate(Slot, CREDENTIAL_CRC_INDEX);
+	Slot[CREDENTIAL_COMMIT_INDEX] = CREDENTIAL_UNCOMMITTED;
+
+	/*
+	 * First write cycle: the whole record, still uncommitted (the slot is one aligned page). Only the external
+	 * write is waited for before the commit marker, the mirror is synchronized once after it.
+	 */
+	if ((NVM_Mirror_WriteBlock(g_SlotAddress[Target_Slot], Slot, CREDENTIAL_SLOT_SIZE) == ERROR) ||
+		(NVM_Sync() == ERROR))
+	{
+		return ERROR;
+	}
+
+	/* Second write cycle: the commit marker makes the new record the active one */
+	Slot[CREDENTIAL_COMMIT_INDEX] = CREDENTIAL_COMMITTED;
+	if ((NVM_Mirror_WriteBlock(g_SlotAddress[Target_Slot] + CREDENTIAL_COMMIT_INDEX, &Slot[CREDENTIAL_COMMIT_INDEX], 1) == ERROR) ||
+		(NVM_Mirror_Sync() == ERROR))
+	{
+		return ERROR;
+	}
+
+	g_ActiveSlot = Target_Slot;
+	g_ActiveSequence = Slot[CREDENTIAL_SEQUENCE_INDEX];
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Layout 4 to 5: replace a PIN stored in clear by its digest in the other slot, then wipe the slot not holding
+ * the digest unless it is an older digest (a clear PIN, or the raw PIN of layout 0 at slot A).
+ * Safe to run again after a reset at any point.
+ */
+uint8 Credential_Upgrade(void)
+{
+	uint8 Slot[CREDENTIAL_SLOT_SIZE];
+	boolean Erased = TRUE;
+	boolean Older_Digest;
+	uint8 i;
+
+	if (g_ActiveSlot == CREDENTIAL_NO_SLOT)
+	{
+		if (g_LegacySlot == CREDENTIAL_NO_SLOT)
+		{
+			/* No password stored */
+			return SUCCESS;
+		}
+
+		if ((NVM_Mirror_ReadBlock(g_SlotAddress[g_LegacySlot], Slot, CREDENTIAL_SLOT_SIZE) == ERROR) ||
+			(Credential_Save(&Slot[CREDENTIAL_LEGACY_PIN_INDEX]) == ERROR))
+		{
+			return ERROR;
+		}
+	}
+
+	/* The other slot (the digest was saved away from the clear PIN) */
+	if (NVM_Mirror_ReadBlock(g_SlotAddress[(g_ActiveSlot == 0) ? 1 : 0], Slot, CREDENTIAL_SLOT_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	Older_Digest = Credential_IsSlotValid(Slot, CREDENTIAL_COMMITTED);
+
+	for (i = 0; i < CREDENTIAL_SLOT_SIZE; i++)
+	{
+		if (Slot[i] != 0xFF)
+		{
+			Erased = FALSE;
+		}
+
+		/* Don't leave a clear PIN on the stack */
+		Slot[i] = 0;
+	}
+
+	if (!Erased && !Older_Digest && (Credential_WipeSlot((g_ActiveSlot == 0) ? 1 : 0) == ERROR))
+	{
+		return ERROR;
+	}
+
+	g_LegacySlot = CREDENTIAL_NO_SLOT;
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Mix a byte of unpredictable data (e.g. user timing) into the salt of the next saved password.
+ */
+void Credential_AddEntropy(uint8 Value)
+{
+	g_Entropy[g_EntropyIndex] ^= Value;
+	g_EntropyIndex = (uint8)((g_EntropyIndex + 1) % CREDENTIAL_SALT_SIZE);
+}
+
+/*
+ * Description:
+ * Hash a fixed PIN with the given work factor, used to time one iteration on the target.
+ */
+void Credential_Benchmark(uint16 Iterations)
+{
+	const uint8 Pin[CREDENTIAL_PIN_SIZE] = {0};
+	uint8 Digest[CREDENTIAL_DIGEST_SIZE];
+
+	Credential_Digest(Pin, g_Entropy, Iterations, Digest);
+
+	/* The digest itself is a little entropy (the pool content) */
+	Credential_AddEntropy(Digest[0]);
+}
+
+/*
+ * Description:
+ * Set the work factor of the next saved passwords from the measured cycles of one iteration, so that a
+ * verification takes at most CREDENTIAL_VERIFY_BUDGET_MS at F_CPU.
+ */
+void Credential_Calibrate(uint32 Cycles_Per_Iteration)
+{
+	uint32 Iterations;
+
+	if (Cycles_Per_Iteration == 0)
+	{
+		return;
+	}
+
+	Iterations = ((uint32)CREDENTIAL_VERIFY_BUDGET_MS * (F_CPU / 1000UL)) / Cycles_Per_Iteration;
+
+	if (Iterations < CREDENTIAL_MIN_ITERATIONS)
+	{
+		Iterations = CREDENTIAL_MIN_ITERATIONS;
+	}
+	else if (Iterations > CREDENTIAL_MAX_ITERATIONS)
+	{
+		Iterations = CREDENTIAL_MAX_ITERATIONS;
+	}
+
+	g_Iterations = (uint16)Iterations;
+	g_IterationCycles = Cycles_Per_Iteration;
+}
+
+/*
+ * Description:
+ * Return the measured cycles of one iteration (0 before Credential_Calibrate).
+ */
+uint32 Credential_GetIterationCycles(void)
+{
+	return g_IterationCycles;
+}
+
+/*
+ * Description:
+ * Return the work factor of the next saved password.
+ */
+uint16 Credential_GetIterations(void)
+{
+	return g_Iterations;
+}
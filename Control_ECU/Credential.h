@@ -0,0 +1,150 @@
+/*****************************************************************************************************************
+ * File Name: Credential.h
+ * Date: 18/10/2026
+ * Driver: Power-Fail-Safe Credential Storage Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "NVM_Layout.h"
+
+#ifndef CREDENTIAL_H_
+#define CREDENTIAL_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+#define CREDENTIAL_PIN_SIZE                  5
+
+/*
+ * The password is double buffered in the two slots of the credential region, each slot is exactly one
+ * 24C16 page so the whole record costs one write cycle. Slot layout:
+ * [0] Sequence number - [1:4] Salt - [5:6] Iterations - [7:13] Digest - [14] CRC-8 of bytes [0:13] -
+ * [15] Commit marker
+ * The PIN itself is never stored, only a salted and iterated BLAKE2s digest of it (see Credential_Verify).
+ */
+#define CREDENTIAL_SLOT_A_ADDRESS            NVM_CREDENTIAL_ADDRESS
+#define CREDENTIAL_SLOT_B_ADDRESS            (NVM_CREDENTIAL_ADDRESS + NVM_CREDENTIAL_RECORD_SIZE)
+#define CREDENTIAL_SLOT_SIZE                 16
+
+#define CREDENTIAL_SEQUENCE_INDEX            0
+#define CREDENTIAL_SALT_INDEX                1
+#define CREDENTIAL_ITERATIONS_INDEX          5
+#define CREDENTIAL_DIGEST_INDEX              7
+#define CREDENTIAL_CRC_INDEX                 14
+#define CREDENTIAL_COMMIT_INDEX              15
+
+#define CREDENTIAL_SALT_SIZE                 4
+#define CREDENTIAL_DIGEST_SIZE               7
+
+/*
+ * The commit marker is written alone after the record, an erased or torn marker means the record never landed.
+ * Layouts 1 to 4 stored the PIN in clear at [1:5] with their own marker, such a slot is never taken as a
+ * digest and is wiped by Credential_Upgrade.
+ */
+#define CREDENTIAL_COMMITTED                 0x5A
+#define CREDENTIAL_PIN_COMMITTED             0xA5
+#define CREDENTIAL_LEGACY_PIN_INDEX          1
+#define CREDENTIAL_UNCOMMITTED               0xFF
+
+#define CREDENTIAL_NO_SLOT                   0xFF
+
+/*
+ * Verification latency budget: the work factor (BLAKE2s compressions per digest) of a new password is the
+ * largest one whose measured time fits in it. Until Credential_Calibrate is called the default one is used.
+ */
+#ifndef CREDENTIAL_VERIFY_BUDGET_MS
+#define CREDENTIAL_VERIFY_BUDGET_MS          250
+#endif
+
+#define CREDENTIAL_DEFAULT_ITERATIONS        32
+#define CREDENTIAL_MIN_ITERATIONS            1
+#define CREDENTIAL_MAX_ITERATIONS            0xFFFF
+
+/*
+ * A record is verified with at most this multiple of the calibrated work factor: its 16-bit work factor is only
+ * covered by the CRC-8, a damaged one mustn't hash past the watchdog period (4 x 250 msec)
+ */
+#define CREDENTIAL_MAX_ITERATIONS_FACTOR     4
+
+/* Iterations timed by the benchmark */
+#define CREDENTIAL_BENCHMARK_ITERATIONS      4
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Boot recovery: read the two slots (two block reads) and select the committed slot with a valid CRC and
+ * the newest sequence number. A half written slot is ignored, so the previous password stays usable.
+ * Returns ERROR only if the EEPROM could not be read.
+ */
+uint8 Credential_Init(void);
+
+/*
+ * Description:
+ * Return TRUE if a committed password was found by Credential_Init or stored by Credential_Save.
+ */
+boolean Credential_IsStored(void);
+
+/*
+ * Description:
+ * Return TRUE if a committed PIN of layouts 1 to 4 (stored in clear) was found by Credential_Init.
+ */
+boolean Credential_IsLegacyStored(void);
+
+/*
+ * Description:
+ * Hash the entered PIN with the salt and the work factor of the active slot and compare it with its digest.
+ * Returns ERROR if there is no stored password, the EEPROM access failed or the external record is corrupted
+ * (a corrupted internal copy falls back to the external one and invalidates the mirror).
+ */
+uint8 Credential_Verify(const uint8 *Pin, boolean *Matched);
+
+/*
+ * Description:
+ * Store the digest of a new PIN into the inactive slot: one page write with the commit marker left erased,
+ * then the commit marker alone. The new record replaces the old one only once the commit marker is written.
+ */
+uint8 Credential_Save(const uint8 *Pin);
+
+/*
+ * Description:
+ * Layout 4 to 5: replace a PIN stored in clear by its digest in the other slot, then wipe the clear one.
+ * Safe to run again after a reset at any point.
+ */
+uint8 Credential_Upgrade(void);
+
+/*
+ * Description:
+ * Mix a byte of unpredictable data (e.g. user timing) into the salt of the next saved password.
+ */
+void Credential_AddEntropy(uint8 Value);
+
+/*
+ * Description:
+ * Hash a fixed PIN with the given work factor, used to time one iteration on the target.
+ */
+void Credential_Benchmark(uint16 Iterations);
+
+/*
+ * Description:
+ * Set the work factor of the next saved passwords from the measured cycles of one iteration, so that a
+ * verification takes at most CREDENTIAL_VERIFY_BUDGET_MS at F_CPU.
+ */
+void Credential_Calibrate(uint32 Cycles_Per_Iteration);
+
+/*
+ * Description:
+ * Return the measured cycles of one iteration (0 before Credential_Calibrate).
+ */
+uint32 Credential_GetIterationCycles(void);
+
+/*
+ * Description:
+ * Return the work factor of the next saved password.
+ */
+uint16 Credential_GetIterations(void);
+
+#endif /* CREDENTIAL_H_ */
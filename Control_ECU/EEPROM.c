@@ -5,35 +5,124 @@
  * Author: Youssef Zaki
  ****************************************************************************************************************/
 #include <avr/io.h>
+#include <util/delay.h>
 #include "I2C.h"
 #include "EEPROM.h"
+#include "Profile.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static EEPROM_StatisticsType g_EEPROM_Statistics;
 
 /****************************************************************************************
- *                                     Functions Definitions                            *
+ *                                     Private Functions                                *
  ****************************************************************************************/
 
-uint8 EEPROM_WriteByte(uint16 EEPROM_Byte_Address, uint8 EEPROM_Data)
+/*
+ * Description:
+ * Let the I2C driver count the failure and release the bus, then fail the transaction.
+ */
+static uint8 EEPROM_Abort(void)
+{
+	TWI_HandleError(TWI_GetStatus());
+
+	return ERROR;
+}
+
+/*
+ * Description:
+ * Exponential back-off before the next attempt (1, 2, 4, ... times EEPROM_RETRY_BACKOFF_MS).
+ * A NACK usually means the EEPROM is still inside its internal write cycle, so waiting is the cure.
+ */
+static void EEPROM_Backoff(uint8 Attempt)
+{
+	uint8 i;
+
+	g_EEPROM_Statistics.Retries++;
+
+	for (i = 0; i < (1 << Attempt); i++)
+	{
+		_delay_ms(EEPROM_RETRY_BACKOFF_MS);
+	}
+}
+
+/*
+ * Description:
+ * Return the device address (R/W=0) of the chip holding the memory location.
+ */
+static uint8 EEPROM_DeviceAddress(EEPROM_AddressType EEPROM_Address)
+{
+#if (EEPROM_ADDRESS_BYTES == 1)
+	/* we need to get A8 A9 A10 address bits from the memory location address */
+	return (uint8)(EEPROM_DEVICE_ADDRESS | ((EEPROM_Address & 0x0700) >> 7));
+#else
+	/* the chip select bits A2 A1 A0 come from the chip number */
+	return (uint8)(EEPROM_DEVICE_ADDRESS | ((uint8)(EEPROM_Address / EEPROM_SIZE) << 1));
+#endif
+}
+
+/*
+ * Description:
+ * Send the Start Bit, the device address (R/W=0) and the memory location address (one or two bytes).
+ * This is the common beginning of every read and write transaction.
+ */
+static uint8 EEPROM_SelectAddress(EEPROM_AddressType EEPROM_Address)
 {
 	/* Send the Start Bit */
 	TWI_Start();
 	if (TWI_GetStatus() != TWI_START)
-		return ERROR;
+		return EEPROM_Abort();
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=0 (write) */
-	TWI_WriteByte((uint8)(0xA0 | ((EEPROM_Byte_Address & 0x0700)>>7)));
+	/* Send the device address with R/W=0 (write) */
+	TWI_WriteByte(EEPROM_DeviceAddress(EEPROM_Address));
 	if (TWI_GetStatus() != TWI_MT_SLA_W_ACK)
-		return ERROR;
+		return EEPROM_Abort();
+
+#if (EEPROM_ADDRESS_BYTES == 2)
+	/* Send the high byte of the memory location address inside the chip */
+	TWI_WriteByte((uint8)((EEPROM_Address % EEPROM_SIZE) >> 8));
+	if (TWI_GetStatus() != TWI_MT_DATA_ACK)
+		return EEPROM_Abort();
+#endif
 
 	/* Send the required memory location address */
-	TWI_WriteByte((uint8)(EEPROM_Byte_Address));
+	TWI_WriteByte((uint8)(EEPROM_Address));
 	if (TWI_GetStatus() != TWI_MT_DATA_ACK)
+		return EEPROM_Abort();
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Send the Repeated Start Bit and the device address with R/W=1 (Read) after EEPROM_SelectAddress.
+ */
+static uint8 EEPROM_SelectRead(EEPROM_AddressType EEPROM_Address)
+{
+	/* Send the Repeated Start Bit */
+	TWI_Start();
+	if (TWI_GetStatus() != TWI_REP_START)
+		return EEPROM_Abort();
+
+	/* Send the device address with R/W=1 (Read) */
+	TWI_WriteByte((uint8)(EEPROM_DeviceAddress(EEPROM_Address) | 1));
+	if (TWI_GetStatus() != TWI_MT_SLA_R_ACK)
+		return EEPROM_Abort();
+
+	return SUCCESS;
+}
+
+static uint8 EEPROM_WriteByteTransaction(EEPROM_AddressType EEPROM_Byte_Address, uint8 EEPROM_Data)
+{
+	if (EEPROM_SelectAddress(EEPROM_Byte_Address) == ERROR)
 		return ERROR;
 
 	/* write byte to EEPROM */
 	TWI_WriteByte(EEPROM_Data);
 	if (TWI_GetStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+		return EEPROM_Abort();
 
 	/* Send the Stop Bit */
 	TWI_Stop();
@@ -41,42 +130,270 @@ uint8 EEPROM_WriteByte(uint16 EEPROM_Byte_Address, uint8 EEPROM_Data)
 	return SUCCESS;
 }
 
-uint8 EEPROM_ReadByte(uint16 EEPROM_Byte_Address, uint8 *EEPROM_Data)
+static uint8 EEPROM_ReadByteTransaction(EEPROM_AddressType EEPROM_Byte_Address, uint8 *EEPROM_Data)
 {
-	/* Send the Start Bit */
-	TWI_Start();
-	if (TWI_GetStatus() != TWI_START)
+	if ((EEPROM_SelectAddress(EEPROM_Byte_Address) == ERROR) || (EEPROM_SelectRead(EEPROM_Byte_Address) == ERROR))
 		return ERROR;
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=0 (write) */
-	TWI_WriteByte((uint8)((0xA0) | ((EEPROM_Byte_Address & 0x0700)>>7)));
-	if (TWI_GetStatus() != TWI_MT_SLA_W_ACK)
+	/* Read Byte from Memory without send ACK */
+	*EEPROM_Data = TWI_ReadByteWithNACK();
+	if (TWI_GetStatus() != TWI_MR_DATA_NACK)
+		return EEPROM_Abort();
+
+	/* Send the Stop Bit */
+	TWI_Stop();
+
+	return SUCCESS;
+}
+
+static uint8 EEPROM_WriteBlockTransaction(EEPROM_AddressType EEPROM_Block_Address, const uint8 *EEPROM_Data, uint16 Length)
+{
+	uint16 i;
+
+	if (EEPROM_SelectAddress(EEPROM_Block_Address) == ERROR)
 		return ERROR;
 
-	/* Send the required memory location address */
-	TWI_WriteByte((uint8)(EEPROM_Byte_Address));
-	if (TWI_GetStatus() != TWI_MT_DATA_ACK)
+	/* write the whole block, the EEPROM increments its internal address after every byte */
+	for (i = 0; i < Length; i++)
+	{
+		TWI_WriteByte(EEPROM_Data[i]);
+		if (TWI_GetStatus() != TWI_MT_DATA_ACK)
+			return EEPROM_Abort();
+	}
+
+	/* Send the Stop Bit to start one internal write cycle for the whole page */
+	TWI_Stop();
+
+	return SUCCESS;
+}
+
+static uint8 EEPROM_ReadBlockTransaction(EEPROM_AddressType EEPROM_Block_Address, uint8 *EEPROM_Data, uint16 Length)
+{
+	uint16 i;
+
+	if ((EEPROM_SelectAddress(EEPROM_Block_Address) == ERROR) || (EEPROM_SelectRead(EEPROM_Block_Address) == ERROR))
 		return ERROR;
 
-	/* Send the Repeated Start Bit */
-	TWI_Start();
-	if (TWI_GetStatus() != TWI_REP_START)
+	/* Sequential read: ACK every byte to let the EEPROM send the next one */
+	for (i = 0; i < (Length - 1); i++)
+	{
+		EEPROM_Data[i] = TWI_ReadByteWithACK();
+		if (TWI_GetStatus() != TWI_MR_DATA_ACK)
+			return EEPROM_Abort();
+	}
+
+	/* Read the last Byte without send ACK to end the sequential read */
+	EEPROM_Data[Length - 1] = TWI_ReadByteWithNACK();
+	if (TWI_GetStatus() != TWI_MR_DATA_NACK)
+		return EEPROM_Abort();
+
+	/* Send the Stop Bit */
+	TWI_Stop();
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Return the number of bytes of the block inside the chip holding its first byte.
+ * A sequential access wraps at the end of the chip instead of moving to the next one.
+ */
+static uint16 EEPROM_ChipChunk(EEPROM_AddressType EEPROM_Address, uint16 Length)
+{
+	uint32 left = EEPROM_SIZE - (EEPROM_Address % EEPROM_SIZE);
+
+	return (left < Length) ? (uint16)left : Length;
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Write one byte, the transaction is retried up to EEPROM_MAX_RETRIES times with back-off.
+ */
+uint8 EEPROM_WriteByte(EEPROM_AddressType EEPROM_Byte_Address, uint8 EEPROM_Data)
+{
+	uint8 attempt;
+
+	for (attempt = 0; attempt <= EEPROM_MAX_RETRIES; attempt++)
+	{
+		if (attempt != 0)
+			EEPROM_Backoff(attempt - 1);
+
+		if (EEPROM_WriteByteTransaction(EEPROM_Byte_Address, EEPROM_Data) == SUCCESS)
+			return SUCCESS;
+	}
+
+	g_EEPROM_Statistics.Failures++;
+	return ERROR;
+}
+
+/*
+ * Description:
+ * Read one byte, the transaction is retried up to EEPROM_MAX_RETRIES times with back-off.
+ */
+uint8 EEPROM_ReadByte(EEPROM_AddressType EEPROM_Byte_Address, uint8 *EEPROM_Data)
+{
+	uint8 attempt;
+
+	for (attempt = 0; attempt <= EEPROM_MAX_RETRIES; attempt++)
+	{
+		if (attempt != 0)
+			EEPROM_Backoff(attempt - 1);
+
+		if (EEPROM_ReadByteTransaction(EEPROM_Byte_Address, EEPROM_Data) == SUCCESS)
+			return SUCCESS;
+	}
+
+	g_EEPROM_Statistics.Failures++;
+	return ERROR;
+}
+
+/*
+ * Description:
+ * Write up to one page of bytes in a single transaction, so the whole block costs one internal write cycle.
+ * The block must not cross a page boundary (the 24Cxx wraps inside the page), otherwise ERROR is returned.
+ */
+uint8 EEPROM_WritePage(EEPROM_AddressType EEPROM_Page_Address, const uint8 *EEPROM_Data, uint8 Length)
+{
+	uint8 attempt;
+
+	/* The 24Cxx wraps inside the current page, so a block crossing the page boundary would overwrite its start */
+	if ((Length == 0) || (((EEPROM_Page_Address % EEPROM_PAGE_SIZE) + Length) > EEPROM_PAGE_SIZE))
 		return ERROR;
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=1 (Read) */
-	TWI_WriteByte((uint8)((0xA0) | ((EEPROM_Byte_Address & 0x0700)>>7) | 1));
-	if (TWI_GetStatus() != TWI_MT_SLA_R_ACK)
+	for (attempt = 0; attempt <= EEPROM_MAX_RETRIES; attempt++)
+	{
+		if (attempt != 0)
+			EEPROM_Backoff(attempt - 1);
+
+		if (EEPROM_WriteBlockTransaction(EEPROM_Page_Address, EEPROM_Data, Length) == SUCCESS)
+			return SUCCESS;
+	}
+
+	g_EEPROM_Statistics.Failures++;
+	return ERROR;
+}
+
+/*
+ * Description:
+ * Write a block of any length without the page boundary check, one transaction per chip.
+ * Only for parts without pages that use the same protocol (I2C FRAM), a 24Cxx would wrap inside the page.
+ */
+uint8 EEPROM_WriteBlock(EEPROM_AddressType EEPROM_Block_Address, const uint8 *EEPROM_Data, uint16 Length)
+{
+	uint8 attempt;
+	uint16 chunk;
+
+	if (Length == 0)
 		return ERROR;
 
-	/* Read Byte from Memory without send ACK */
-	*EEPROM_Data = TWI_ReadByteWithNACK();
-	if (TWI_GetStatus() != TWI_MR_DATA_NACK)
+	while (Length > 0)
+	{
+		chunk = EEPROM_ChipChunk(EEPROM_Block_Address, Length);
+
+		for (attempt = 0; attempt <= EEPROM_MAX_RETRIES; attempt++)
+		{
+			if (attempt != 0)
+				EEPROM_Backoff(attempt - 1);
+
+			if (EEPROM_WriteBlockTransaction(EEPROM_Block_Address, EEPROM_Data, chunk) == SUCCESS)
+				break;
+		}
+
+		if (attempt > EEPROM_MAX_RETRIES)
+		{
+			g_EEPROM_Statistics.Failures++;
+			return ERROR;
+		}
+
+		EEPROM_Block_Address += chunk;
+		EEPROM_Data += chunk;
+		Length -= chunk;
+	}
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Read a block of bytes using one sequential read transaction per chip (ACK every byte except the last one).
+ */
+uint8 EEPROM_ReadBlock(EEPROM_AddressType EEPROM_Block_Address, uint8 *EEPROM_Data, uint16 Length)
+{
+	uint8 attempt;
+	uint16 chunk;
+
+	if (Length == 0)
 		return ERROR;
 
+	/* Every read of the external memory comes here (NVM_ReadBlock), one block with its retries is one duration */
+	PROFILE_ENTER(PROFILE_EEPROM_READ_BLOCK);
+
+	while (Length > 0)
+	{
+		chunk = EEPROM_ChipChunk(EEPROM_Block_Address, Length);
+
+		for (attempt = 0; attempt <= EEPROM_MAX_RETRIES; attempt++)
+		{
+			if (attempt != 0)
+				EEPROM_Backoff(attempt - 1);
+
+			if (EEPROM_ReadBlockTransaction(EEPROM_Block_Address, EEPROM_Data, chunk) == SUCCESS)
+				break;
+		}
+
+		if (attempt > EEPROM_MAX_RETRIES)
+		{
+			g_EEPROM_Statistics.Failures++;
+			PROFILE_EXIT(PROFILE_EEPROM_READ_BLOCK);
+			return ERROR;
+		}
+
+		EEPROM_Block_Address += chunk;
+		EEPROM_Data += chunk;
+		Length -= chunk;
+	}
+
+	PROFILE_EXIT(PROFILE_EEPROM_READ_BLOCK);
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Acknowledge polling: the EEPROM doesn't acknowledge its address during the internal write cycle.
+ * Polls the chip holding the given address. Returns TRUE once it acknowledges, a NACK here is expected and
+ * not counted as a failure.
+ */
+boolean EEPROM_IsReady(EEPROM_AddressType EEPROM_Address)
+{
+	uint8 status;
+
+	/* Send the Start Bit */
+	TWI_Start();
+	if (TWI_GetStatus() != TWI_START)
+	{
+		EEPROM_Abort();
+		return FALSE;
+	}
+
+	/* Send the device address with R/W=0 (write) and check if it is acknowledged */
+	TWI_WriteByte(EEPROM_DeviceAddress(EEPROM_Address));
+	status = TWI_GetStatus();
+
 	/* Send the Stop Bit */
 	TWI_Stop();
 
-	return SUCCESS;
+	return (status == TWI_MT_SLA_W_ACK);
+}
+
+/*
+ * Description:
+ * Return the retry statistics of the EEPROM driver, the bus failures are counted by the I2C driver.
+ */
+const EEPROM_StatisticsType* EEPROM_GetStatistics(void)
+{
+	return &g_EEPROM_Statistics;
 }
@@ -4,7 +4,7 @@
  * Driver: EEPROM Driver Header File
  * Author: Youssef Zaki
  ****************************************************************************************************************/
-#include "Standard_types.h"
+#include "Standard_Types.h"
 
 #ifndef EEPROM_H_
 #define EEPROM_H_
@@ -15,12 +15,144 @@
 #define ERROR 0
 #define SUCCESS 1
 
+/* Supported parts */
+#define EEPROM_24C16                         16
+#define EEPROM_24C32                         32
+#define EEPROM_24C64                         64
+#define EEPROM_24C128                        128
+#define EEPROM_24C256                        256
+#define EEPROM_24C512                        512
+
+/* Part fitted on the board */
+#ifndef EEPROM_PART
+#define EEPROM_PART                          EEPROM_24C16
+#endif
+
+/*
+ * Geometry of one chip:
+ * 24C16: the memory address bits A8 A9 A10 go in the device address and one address byte follows.
+ * 24C32 - 24C512: two address bytes follow the device address, which carries the chip select pins A2 A1 A0.
+ */
+#if (EEPROM_PART == EEPROM_24C16)
+#define EEPROM_SIZE                          2048UL
+#define EEPROM_PAGE_SIZE                     16
+#define EEPROM_ADDRESS_BYTES                 1
+#elif (EEPROM_PART == EEPROM_24C32)
+#define EEPROM_SIZE                          4096UL
+#define EEPROM_PAGE_SIZE                     32
+#define EEPROM_ADDRESS_BYTES                 2
+#elif (EEPROM_PART == EEPROM_24C64)
+#define EEPROM_SIZE                          8192UL
+#define EEPROM_PAGE_SIZE                     32
+#define EEPROM_ADDRESS_BYTES                 2
+#elif (EEPROM_PART == EEPROM_24C128)
+#define EEPROM_SIZE                          16384UL
+#define EEPROM_PAGE_SIZE                     64
+#define EEPROM_ADDRESS_BYTES                 2
+#elif (EEPROM_PART == EEPROM_24C256)
+#define EEPROM_SIZE                          32768UL
+#define EEPROM_PAGE_SIZE                     64
+#define EEPROM_ADDRESS_BYTES                 2
+#elif (EEPROM_PART == EEPROM_24C512)
+#define EEPROM_SIZE                          65536UL
+#define EEPROM_PAGE_SIZE                     128
+#define EEPROM_ADDRESS_BYTES                 2
+#else
+
+#error "EEPROM part should be 24C16, 24C32, 24C64, 24C128, 24C256 or 24C512"
+
+#endif
+
+/*
+ * Chips sharing the bus, strapped to consecutive A2 A1 A0 values from 0. They are seen as one memory,
+ * chip N holds the addresses [N * EEPROM_SIZE, (N + 1) * EEPROM_SIZE). The 24C16 has no chip select pins.
+ */
+#ifndef EEPROM_CHIPS
+#define EEPROM_CHIPS                         1
+#endif
+
+#if ((EEPROM_CHIPS < 1) || (EEPROM_CHIPS > 8) || ((EEPROM_ADDRESS_BYTES == 1) && (EEPROM_CHIPS != 1)))
+
+#error "EEPROM chips should be 1 to 8, only one 24C16 fits on the bus"
+
+#endif
+
+#define EEPROM_TOTAL_SIZE                    (EEPROM_SIZE * EEPROM_CHIPS)
+
+/* Device address of the first chip, R/W=0 */
+#define EEPROM_DEVICE_ADDRESS                0xA0
+
+/* Maximum internal write cycle time (tWR) after every write transaction (10 msec covers every vendor) */
+#define EEPROM_WRITE_CYCLE_MS                10
+
+/* Retry policy: every failed transaction is released with a STOP and retried after 1, 2, 4, 8 msec */
+#define EEPROM_MAX_RETRIES                   4
+#define EEPROM_RETRY_BACKOFF_MS              1
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Memory location address, 32 bits only when the memory is larger than 64 KB */
+#if (EEPROM_TOTAL_SIZE > 65536UL)
+typedef uint32 EEPROM_AddressType;
+#else
+typedef uint16 EEPROM_AddressType;
+#endif
+
+typedef struct{
+	uint16 Retries;            /* transactions repeated after a failure */
+	uint16 Failures;           /* operations that failed after all the retries */
+}EEPROM_StatisticsType;
+
 /*******************************************************************************************
  *                                      Functions Prototypes                               *
  *******************************************************************************************/
 
-uint8 EEPROM_WriteByte(uint16 EEPROM_Byte_Address, uint8 EEPROM_Data);
+/*
+ * Description:
+ * Write one byte, the transaction is retried up to EEPROM_MAX_RETRIES times with back-off.
+ */
+uint8 EEPROM_WriteByte(EEPROM_AddressType EEPROM_Byte_Address, uint8 EEPROM_Data);
+
+/*
+ * Description:
+ * Read one byte, the transaction is retried up to EEPROM_MAX_RETRIES times with back-off.
+ */
+uint8 EEPROM_ReadByte(EEPROM_AddressType EEPROM_Byte_Address, uint8 *EEPROM_Data);
+
+/*
+ * Description:
+ * Write up to one page of bytes in a single transaction, so the whole block costs one internal write cycle.
+ * The block must not cross a page boundary (the 24Cxx wraps inside the page), otherwise ERROR is returned.
+ */
+uint8 EEPROM_WritePage(EEPROM_AddressType EEPROM_Page_Address, const uint8 *EEPROM_Data, uint8 Length);
+
+/*
+ * Description:
+ * Write a block of any length without the page boundary check, one transaction per chip.
+ * Only for parts without pages that use the same protocol (I2C FRAM), a 24Cxx would wrap inside the page.
+ */
+uint8 EEPROM_WriteBlock(EEPROM_AddressType EEPROM_Block_Address, const uint8 *EEPROM_Data, uint16 Length);
+
+/*
+ * Description:
+ * Read a block of bytes using one sequential read transaction per chip (ACK every byte except the last one).
+ */
+uint8 EEPROM_ReadBlock(EEPROM_AddressType EEPROM_Block_Address, uint8 *EEPROM_Data, uint16 Length);
+
+/*
+ * Description:
+ * Acknowledge polling: the EEPROM doesn't acknowledge its address during the internal write cycle.
+ * Polls the chip holding the given address. Returns TRUE once it acknowledges, a NACK here is expected and
+ * not counted as a failure.
+ */
+boolean EEPROM_IsReady(EEPROM_AddressType EEPROM_Address);
 
-uint8 EEPROM_ReadByte(uint16 EEPROM_Byte_Address, uint8 *EEPROM_Data);
+/*
+ * Description:
+ * Return the retry statistics of the EEPROM driver, the bus failures are counted by the I2C driver.
+ */
+const EEPROM_StatisticsType* EEPROM_GetStatistics(void);
 
 #endif /* EEPROM_H_ */
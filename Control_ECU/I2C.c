@@ -5,9 +5,166 @@
  * Author: Youssef Zaki
  ****************************************************************************************************************/
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include <util/atomic.h>
 #include "I2C.h"
+#include "GPIO.h"
 #include "Common_Macros.h"
 
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Copy of the last configuration to re-initialize the TWI after a bus recovery */
+static TWI_ConfigType g_TWI_Config;
+
+/* Set when the last operation timed out, so TWI_GetStatus reports TWI_NO_INFO */
+static boolean g_TWI_TimedOut = FALSE;
+
+static TWI_ErrorCountersType g_TWI_ErrorCounters;
+
+/* Register map served in slave mode, NULL_PTR while the slave mode is off */
+static volatile uint8 *g_TWI_SlaveRegisters = NULL_PTR;
+static uint8 g_TWI_SlaveSize = 0;
+static uint8 g_TWI_SlaveWritableStart = 0;
+
+/* Copy of the register map taken when a read is addressed */
+static volatile uint8 g_TWI_SlaveSnapshot[TWI_SLAVE_MAX_REGISTERS];
+
+static volatile uint8 g_TWI_SlavePointer = 0;
+static volatile boolean g_TWI_SlavePointerReceived = FALSE;
+static volatile boolean g_TWI_SlaveWritten = FALSE;
+
+/* Set from the own address until the end of the transfer, the master functions don't start meanwhile */
+static volatile boolean g_TWI_SlaveActive = FALSE;
+
+/* Global variables to hold the address of the call back function in the application */
+static void (*volatile g_TWI_SlaveCallBackPtr)(void) = NULL_PTR;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Bounded wait for TWINT = 1, the operation is marked as timed out if it never finishes.
+ */
+static void TWI_WaitForFlag(void)
+{
+	uint32 loops = 0;
+
+	g_TWI_TimedOut = FALSE;
+
+	while (BIT_IS_CLEAR(TWCR, TWINT))
+	{
+		loops++;
+		if (loops >= TWI_TIMEOUT_LOOPS)
+		{
+			g_TWI_TimedOut = TRUE;
+			return;
+		}
+	}
+}
+
+/*
+ * Description:
+ * Copy the register map for the read being addressed (called from the TWI interrupt).
+ */
+static void TWI_Slave_TakeSnapshot(void)
+{
+	uint8 i;
+
+	for (i = 0; i < g_TWI_SlaveSize; i++)
+	{
+		g_TWI_SlaveSnapshot[i] = g_TWI_SlaveRegisters[i];
+	}
+}
+
+/*
+ * Description:
+ * Return the register at the register pointer from the copy and move the pointer (called from the TWI interrupt).
+ */
+static uint8 TWI_Slave_NextByte(void)
+{
+	if (g_TWI_SlavePointer >= g_TWI_SlaveSize)
+	{
+		return TWI_SLAVE_FILL_BYTE;
+	}
+
+	return g_TWI_SlaveSnapshot[g_TWI_SlavePointer++];
+}
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Interrupt for the slave mode, only enabled (TWIE) while no master operation is running */
+ISR(TWI_vect)
+{
+	switch (TWSR & 0xF8)
+	{
+	case TWI_SR_SLA_W_ACK:
+	case TWI_SR_ARB_LOST_SLA_W:
+		g_TWI_SlaveActive = TRUE;
+		g_TWI_SlavePointerReceived = FALSE;
+		break;
+
+	case TWI_SR_DATA_ACK:
+		if (!g_TWI_SlavePointerReceived)
+		{
+			/* The first byte of a write is the register pointer */
+			g_TWI_SlavePointer = TWDR;
+			g_TWI_SlavePointerReceived = TRUE;
+		}
+		else
+		{
+			if ((g_TWI_SlavePointer >= g_TWI_SlaveWritableStart) && (g_TWI_SlavePointer < g_TWI_SlaveSize))
+			{
+				g_TWI_SlaveRegisters[g_TWI_SlavePointer] = TWDR;
+				g_TWI_SlaveWritten = TRUE;
+			}
+			g_TWI_SlavePointer++;
+		}
+		break;
+
+	case TWI_SR_STOP:
+		/* End of a write, or repeated START before a read from the register pointer */
+		g_TWI_SlaveActive = FALSE;
+		if (g_TWI_SlaveWritten && (g_TWI_SlaveCallBackPtr != NULL_PTR))
+		{
+			(*g_TWI_SlaveCallBackPtr)();
+		}
+		g_TWI_SlaveWritten = FALSE;
+		break;
+
+	case TWI_ST_SLA_R_ACK:
+	case TWI_ST_ARB_LOST_SLA_R:
+		g_TWI_SlaveActive = TRUE;
+		TWI_Slave_TakeSnapshot();
+		TWDR = TWI_Slave_NextByte();
+		break;
+
+	case TWI_ST_DATA_ACK:
+		TWDR = TWI_Slave_NextByte();
+		break;
+
+	case TWI_BUS_ERROR:
+		/* Release the bus lines and keep answering the own address */
+		g_TWI_SlaveActive = FALSE;
+		TWCR = (1<<TWINT) | (1<<TWSTO) | (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+		return;
+
+	default:
+		/* TWI_SR_DATA_NACK, TWI_ST_DATA_NACK, TWI_ST_LAST_DATA_ACK: the transfer is over */
+		g_TWI_SlaveActive = FALSE;
+		break;
+	}
+
+	/* Clear TWINT and keep acknowledging the own address */
+	TWCR = (1<<TWINT) | (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+}
+
 /****************************************************************************************
  *                                     Functions Definitions                            *
  ****************************************************************************************/
@@ -16,11 +173,14 @@
  * Description:
  * Set TWEN (TWI Enable Bit) bit in TWCR Register to activate TWI operation.
  * Two Wire Bus address my address if any master device want to call me: 0x01(used in case this MC is a slave device)
- * Bit Rate: 400.000 kbps at F_CPU = 8Mhz
+ * Bit Rate: TWI_SCL_FREQUENCY, use TWI_BIT_RATE_VALUE and TWI_PRESCALER_SELECT in the configuration structure.
  *
  */
 void TWI_Init(TWI_ConfigType *Config_Ptr)
 {
+	/* Keep the configuration for re-initialization after a bus recovery */
+	g_TWI_Config = *Config_Ptr;
+
 	/* Setting Bit Rate and pre-scaler values from configurable structure  */
 	    TWBR = (Config_Ptr -> I2C_Bit_Rate);
 		TWSR = (Config_Ptr -> I2C_Prescaler);
@@ -28,8 +188,16 @@ void TWI_Init(TWI_ConfigType *Config_Ptr)
 		/* Setting Bus address value from configurable structure  */
 		TWAR = ((Config_Ptr -> I2C_Address) << TWA0);
 
-		/* enable TWI */
-	    TWCR = (1<<TWEN);
+		/* enable TWI, and answer the own address if the slave mode is on */
+	    if (g_TWI_SlaveRegisters != NULL_PTR)
+	    {
+	    	g_TWI_SlaveActive = FALSE;
+	    	TWCR = (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+	    }
+	    else
+	    {
+	    	TWCR = (1<<TWEN);
+	    }
 }
 
 /*
@@ -41,9 +209,31 @@ void TWI_Init(TWI_ConfigType *Config_Ptr)
  */
 void TWI_Start(void)
 {
-	TWCR |= (1<<TWINT) | (1<<TWSTA) | (1<<TWEN);
+	uint16 steps = 0;
+	boolean started = FALSE;
+
+	/* Let a running slave transfer end first, a full map read is TWI_SLAVE_TRANSFER_US long */
+	while (!started)
+	{
+		/* No address match may start a slave transfer between the check and the takeover */
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if (!g_TWI_SlaveActive || (steps >= TWI_SLAVE_WAIT_STEPS))
+			{
+				/* The slave interrupt is disabled (TWIE = 0) until the STOP of this master operation */
+				TWCR = (1<<TWINT) | (1<<TWSTA) | (1<<TWEN);
+				started = TRUE;
+			}
+		}
+
+		if (!started)
+		{
+			_delay_us(TWI_SLAVE_WAIT_STEP_US);
+			steps++;
+		}
+	}
 
-	while (BIT_IS_CLEAR(TWCR, TWINT));
+	TWI_WaitForFlag();
 }
 
 /*
@@ -54,7 +244,22 @@ void TWI_Start(void)
  */
 void TWI_Stop(void)
 {
+	uint32 loops = 0;
+
 	TWCR = (1<<TWINT) | (1<<TWSTO) | (1<<TWEN);
+
+	/* TWSTO is cleared by hardware once the STOP is on the bus, don't wait forever if SCL is held low */
+	while (BIT_IS_SET(TWCR, TWSTO) && (loops < TWI_TIMEOUT_LOOPS))
+	{
+		loops++;
+	}
+
+	/* Give the TWI back to the slave interrupt */
+	if (g_TWI_SlaveRegisters != NULL_PTR)
+	{
+		g_TWI_SlaveActive = FALSE;
+		TWCR = (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+	}
 }
 
 /*
@@ -70,7 +275,7 @@ void TWI_WriteByte(uint8 Byte)
 
 	TWCR = (1<<TWINT) | (1<<TWEN);
 
-	while(BIT_IS_CLEAR(TWCR, TWINT));
+	TWI_WaitForFlag();
 }
 
 /*
@@ -84,7 +289,7 @@ uint8 TWI_ReadByteWithACK(void)
 {
 	TWCR = (1<<TWINT) | (1<<TWEA) | (1<<TWEN);
 
-	while(BIT_IS_CLEAR(TWCR, TWINT));
+	TWI_WaitForFlag();
 
 	return TWDR;
 }
@@ -100,7 +305,7 @@ uint8 TWI_ReadByteWithNACK(void)
 {
 	TWCR = (1<<TWINT) | (1<<TWEN);
 
-	while(BIT_IS_CLEAR(TWCR, TWINT));
+	TWI_WaitForFlag();
 
 	return TWDR;
 }
@@ -113,7 +318,152 @@ uint8 TWI_GetStatus(void)
 {
     uint8 status;
 
+    /* A timed out operation has no relevant status */
+    if (g_TWI_TimedOut)
+    {
+        return TWI_NO_INFO;
+    }
+
     status = TWSR & 0xF8;
 
     return status;
 }
+
+/*
+ * Description:
+ * Called by the upper layer when the status is not the expected one:
+ * 1. Count the failure in its class.
+ * 2. Release the bus with a STOP condition (also clears the TWI hardware from a bus error).
+ * 3. After a timeout or a bus error, recover a stuck slave with TWI_BusRecovery.
+ */
+void TWI_HandleError(uint8 Status)
+{
+	switch (Status)
+	{
+	case TWI_NO_INFO:
+		g_TWI_ErrorCounters.Timeouts++;
+		break;
+
+	case TWI_MT_SLA_W_NACK:
+	case TWI_MT_DATA_NACK:
+	case TWI_MT_SLA_R_NACK:
+		g_TWI_ErrorCounters.Nacks++;
+		break;
+
+	case TWI_BUS_ERROR:
+		g_TWI_ErrorCounters.Bus_Errors++;
+		break;
+
+	case TWI_ARBITRATION_LOST:
+	case TWI_SR_ARB_LOST_SLA_W:
+	case TWI_ST_ARB_LOST_SLA_R:
+		g_TWI_ErrorCounters.Arbitration_Lost++;
+		break;
+
+	default:
+		g_TWI_ErrorCounters.Unexpected_Status++;
+		break;
+	}
+
+	/* Never leave the bus owned by this master after a failure */
+	TWI_Stop();
+
+	if ((Status == TWI_NO_INFO) || (Status == TWI_BUS_ERROR))
+	{
+		TWI_BusRecovery();
+	}
+}
+
+/*
+ * Description:
+ * Recover the bus when a slave holds SDA low (e.g. reset in the middle of a read):
+ * 1. Disable the TWI to get manual control of SCL and SDA pins.
+ * 2. Clock SCL up to nine times until the slave releases SDA.
+ * 3. Generate a STOP condition manually and re-initialize the TWI with the last configuration.
+ */
+void TWI_BusRecovery(void)
+{
+	uint8 i;
+
+	/* Disable the TWI, the pins return to the GPIO driver */
+	TWCR = 0;
+
+	/*
+	 * Open drain emulation: the output latch is LOW and the pin is released (input) for a HIGH level
+	 * by the bus pull-up resistors, or driven (output) for a LOW level.
+	 */
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SCL_PIN_ID, INPUT_PIN);
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SDA_PIN_ID, INPUT_PIN);
+	GPIO_WritePin(TWI_PORT_ID, TWI_SCL_PIN_ID, LOGIC_LOW);
+	GPIO_WritePin(TWI_PORT_ID, TWI_SDA_PIN_ID, LOGIC_LOW);
+	_delay_us(5);
+
+	/* Clock SCL at about 100 kHz until the slave releases SDA */
+	for (i = 0; (i < TWI_RECOVERY_CLOCKS) && (GPIO_ReadPin(TWI_PORT_ID, TWI_SDA_PIN_ID) == LOGIC_LOW); i++)
+	{
+		GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SCL_PIN_ID, OUTPUT_PIN);
+		_delay_us(5);
+		GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SCL_PIN_ID, INPUT_PIN);
+		_delay_us(5);
+	}
+
+	/* STOP condition: SDA rising while SCL is high */
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SCL_PIN_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SDA_PIN_ID, OUTPUT_PIN);
+	_delay_us(5);
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SCL_PIN_ID, INPUT_PIN);
+	_delay_us(5);
+	GPIO_SetupPinDirection(TWI_PORT_ID, TWI_SDA_PIN_ID, INPUT_PIN);
+	_delay_us(5);
+
+	g_TWI_ErrorCounters.Recoveries++;
+
+	/* Give the pins back to the TWI hardware */
+	TWI_Init(&g_TWI_Config);
+}
+
+/*
+ * Description:
+ * Return the failure counters of the TWI bus.
+ */
+const TWI_ErrorCountersType* TWI_GetErrorCounters(void)
+{
+	return &g_TWI_ErrorCounters;
+}
+
+/*
+ * Description:
+ * Answer the own address (TWAR) from the TWI interrupt with a register map, without any polling:
+ * 1. A master write sets the register pointer with its first byte, the next bytes are written from there
+ *    (only the registers from Writable_Start are written, the others are ignored).
+ * 2. A master read returns the registers from the register pointer, which increments after every byte.
+ *    The map is copied when the read is addressed, so a multi-byte register is never read half updated
+ *    as long as the application updates it with the interrupts disabled.
+ * The master functions take the TWI from the interrupt while they own the bus and give it back at the STOP.
+ * The I-bit must be set.
+ */
+void TWI_Slave_Init(volatile uint8 *Registers, uint8 Size, uint8 Writable_Start)
+{
+	if (Size > TWI_SLAVE_MAX_REGISTERS)
+	{
+		Size = TWI_SLAVE_MAX_REGISTERS;
+	}
+
+	g_TWI_SlaveSize = Size;
+	g_TWI_SlaveWritableStart = Writable_Start;
+	g_TWI_SlavePointer = 0;
+	g_TWI_SlaveRegisters = Registers;
+
+	/* Acknowledge the own address from now on */
+	g_TWI_SlaveActive = FALSE;
+	TWCR = (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+}
+
+/*
+ * Description:
+ * Function to set the Call Back function called from the TWI interrupt at the end of a master write.
+ */
+void TWI_Slave_SetCallBack(void(*a_ptr)(void))
+{
+	g_TWI_SlaveCallBackPtr = a_ptr;
+}
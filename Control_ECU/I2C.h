@@ -13,6 +13,58 @@
  *                                    Macros Definitions                                  *
  ******************************************************************************************/
 
+/*
+ * Required SCL frequency in Hz, TWBR and the pre-scaler are derived from it and F_CPU at compile time:
+ * SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS)
+ * 100 kHz for standard parts, 400 kHz for Fast-mode, up to F_CPU/16 (500 kHz at 8 MHz, 1 MHz at 16 MHz)
+ * for FRAM parts which accept Fast-mode Plus.
+ */
+#ifndef TWI_SCL_FREQUENCY
+#define TWI_SCL_FREQUENCY                    400000UL
+#endif
+
+#ifndef F_CPU
+#error "F_CPU must be defined to derive the TWI bit rate"
+#endif
+
+/* Fastest SCL the bit rate generator can produce (TWBR = 0) and the slowest one (TWBR = 255, TWPS = 64) */
+#define TWI_SCL_MAX_FREQUENCY                (F_CPU / 16UL)
+#define TWI_SCL_MIN_FREQUENCY                (F_CPU / (16UL + (2UL * 255UL * 64UL)))
+
+/* TWBR for a pre-scaler value, rounded up so the bus never runs faster than requested */
+#define TWI_TWBR_FOR(PRESCALER_VALUE) \
+	((((F_CPU / TWI_SCL_FREQUENCY) - 16UL) + ((2UL * (PRESCALER_VALUE)) - 1UL)) / (2UL * (PRESCALER_VALUE)))
+
+/* Smallest pre-scaler giving a TWBR that fits in 8 bits (best resolution) */
+#define TWI_PRESCALER_VALUE \
+	((TWI_TWBR_FOR(1UL) <= 255UL) ? 1UL : (TWI_TWBR_FOR(4UL) <= 255UL) ? 4UL : (TWI_TWBR_FOR(16UL) <= 255UL) ? 16UL : 64UL)
+
+#define TWI_PRESCALER_SELECT \
+	((TWI_PRESCALER_VALUE == 1UL) ? Prescaler_1 : (TWI_PRESCALER_VALUE == 4UL) ? Prescaler_4 : \
+	 (TWI_PRESCALER_VALUE == 16UL) ? Prescaler_16 : Prescaler_64)
+
+#define TWI_BIT_RATE_VALUE                   ((uint8)TWI_TWBR_FOR(TWI_PRESCALER_VALUE))
+
+/* SCL frequency really generated with the derived register values */
+#define TWI_SCL_ACTUAL_FREQUENCY \
+	(F_CPU / (16UL + (2UL * TWI_TWBR_FOR(TWI_PRESCALER_VALUE) * TWI_PRESCALER_VALUE)))
+
+#if ((TWI_SCL_FREQUENCY > TWI_SCL_MAX_FREQUENCY) || (TWI_SCL_FREQUENCY < TWI_SCL_MIN_FREQUENCY))
+
+#error "TWI_SCL_FREQUENCY is unreachable with this F_CPU"
+
+#endif
+
+/*
+ * The data sheet recommends TWBR >= 10 in master mode, below it only parts tolerating short SCL high time
+ * (FRAM) are guaranteed to work. Define TWI_STRICT_BIT_RATE to reject such configurations.
+ */
+#if (defined(TWI_STRICT_BIT_RATE) && (TWI_PRESCALER_VALUE == 1UL) && (TWI_TWBR_FOR(1UL) < 10UL))
+
+#error "TWI_SCL_FREQUENCY needs TWBR < 10 at this F_CPU"
+
+#endif
+
 /* I2C Status Bits in the TWSR Register */
 #define TWI_START         0x08 /* start has been sent */
 #define TWI_REP_START     0x10 /* repeated start */
@@ -22,6 +74,72 @@
 #define TWI_MR_DATA_ACK   0x50 /* Master received data and send ACK to slave. */
 #define TWI_MR_DATA_NACK  0x58 /* Master received data but doesn't send ACK to slave. */
 
+/* I2C Failure Status Bits in the TWSR Register */
+#define TWI_BUS_ERROR         0x00 /* illegal START or STOP condition on the bus. */
+#define TWI_MT_SLA_W_NACK     0x20 /* slave address + Write request transmitted but NOT ACK received (slave busy or absent). */
+#define TWI_MT_DATA_NACK      0x30 /* data transmitted but NOT ACK received from slave. */
+#define TWI_ARBITRATION_LOST  0x38 /* another master took the bus. */
+#define TWI_MT_SLA_R_NACK     0x48 /* slave address + Read request transmitted but NOT ACK received. */
+#define TWI_NO_INFO           0xF8 /* no relevant state (TWINT was never set, reported after a wait timeout). */
+
+/* I2C Slave Status Bits in the TWSR Register */
+#define TWI_SR_SLA_W_ACK        0x60 /* own address + Write request received and ACK returned. */
+#define TWI_SR_ARB_LOST_SLA_W   0x68 /* arbitration lost as master, then own address + Write request received. */
+#define TWI_SR_DATA_ACK         0x80 /* data received after own address and ACK returned. */
+#define TWI_SR_DATA_NACK        0x88 /* data received after own address and NOT ACK returned. */
+#define TWI_SR_STOP             0xA0 /* STOP or repeated START received while addressed as slave. */
+#define TWI_ST_SLA_R_ACK        0xA8 /* own address + Read request received and ACK returned. */
+#define TWI_ST_ARB_LOST_SLA_R   0xB0 /* arbitration lost as master, then own address + Read request received. */
+#define TWI_ST_DATA_ACK         0xB8 /* data transmitted and ACK received from the master. */
+#define TWI_ST_DATA_NACK        0xC0 /* data transmitted and NOT ACK received from the master (end of the read). */
+#define TWI_ST_LAST_DATA_ACK    0xC8 /* last data transmitted (TWEA = 0) and ACK received from the master. */
+
+/*
+ * Upper bound of the TWINT and TWSTO polling loops: twice the time of a byte and its acknowledge (9 bit times at
+ * TWI_SCL_ACTUAL_FREQUENCY) plus TWI_CLOCK_STRETCH_US for a slave stretching SCL, so only a stuck bus or a slave
+ * holding SCL low can reach it at any bit rate (1046 usec at 400 kHz, 75 msec at the slowest SCL of 8 Mhz).
+ * An iteration takes at least TWI_TIMEOUT_LOOP_CYCLES cycles, the real wait is never shorter.
+ */
+#ifndef TWI_CLOCK_STRETCH_US
+#define TWI_CLOCK_STRETCH_US  1000UL
+#endif
+
+#define TWI_BYTE_US           (((9UL * 1000000UL) + TWI_SCL_ACTUAL_FREQUENCY - 1UL) / TWI_SCL_ACTUAL_FREQUENCY)
+#define TWI_TIMEOUT_US        ((2UL * TWI_BYTE_US) + TWI_CLOCK_STRETCH_US)
+#define TWI_TIMEOUT_LOOP_CYCLES  4UL
+#define TWI_TIMEOUT_LOOPS     ((TWI_TIMEOUT_US * (F_CPU / 1000UL)) / (1000UL * TWI_TIMEOUT_LOOP_CYCLES))
+
+/* TWI Pins, used to clock-out a slave that holds SDA low */
+#define TWI_PORT_ID           PORTC_ID
+#define TWI_SCL_PIN_ID        PIN0_ID
+#define TWI_SDA_PIN_ID        PIN1_ID
+
+/* Number of SCL pulses to let a stuck slave finish its byte and release SDA */
+#define TWI_RECOVERY_CLOCKS   9
+
+/* Largest register map served in slave mode, a read is answered from a copy of the whole map */
+#define TWI_SLAVE_MAX_REGISTERS  48
+
+/* Value read beyond the end of the register map */
+#define TWI_SLAVE_FILL_BYTE      0xFF
+
+/*
+ * Longest slave transfer a master operation waits for: a read of the whole map (address, register index,
+ * repeated start and address, then TWI_SLAVE_MAX_REGISTERS bytes) at about 10 bit times a byte, clocked by the
+ * other master at the bus rate, taken as TWI_SCL_FREQUENCY but never faster than the 100 kbps standard mode.
+ * 48 registers at 100 kbps: 5.1 msec, the wait is polled in TWI_SLAVE_WAIT_STEP_US steps.
+ */
+#if (TWI_SCL_FREQUENCY < 100000UL)
+#define TWI_SLAVE_SCL_FREQUENCY  TWI_SCL_FREQUENCY
+#else
+#define TWI_SLAVE_SCL_FREQUENCY  100000UL
+#endif
+
+#define TWI_SLAVE_TRANSFER_US \
+	(((TWI_SLAVE_MAX_REGISTERS + 3UL) * 10UL * 1000000UL) / TWI_SLAVE_SCL_FREQUENCY)
+#define TWI_SLAVE_WAIT_STEP_US   10
+#define TWI_SLAVE_WAIT_STEPS     ((uint16)((TWI_SLAVE_TRANSFER_US / TWI_SLAVE_WAIT_STEP_US) + 1UL))
+
 /*******************************************************************************************
  *                                      Types Declaration                                  *
  *******************************************************************************************/
@@ -35,6 +153,16 @@ typedef struct{
 	uint8 I2C_Bit_Rate;
 	TWI_PrescalarSelect I2C_Prescaler;
 }TWI_ConfigType;
+
+/* Failure counters, one per failure class */
+typedef struct{
+	uint16 Timeouts;           /* TWINT never set within TWI_TIMEOUT_LOOPS */
+	uint16 Nacks;              /* slave address or data not acknowledged */
+	uint16 Bus_Errors;         /* illegal START or STOP detected by the TWI hardware */
+	uint16 Arbitration_Lost;   /* another master won the bus */
+	uint16 Unexpected_Status;  /* any other status than the expected one */
+	uint16 Recoveries;         /* SCL clock-out recoveries performed */
+}TWI_ErrorCountersType;
 /*******************************************************************************************
  *                                      Functions Prototypes                               *
  *******************************************************************************************/
@@ -43,7 +171,7 @@ typedef struct{
  * Description:
  * Set TWEN (TWI Enable Bit) bit in TWCR Register to activate TWI operation.
  * Two Wire Bus address my address if any master device want to call me: 0x01(used in case this MC is a slave device)
- * Bit Rate: 400.000 kbps at F_CPU = 8Mhz
+ * Bit Rate: TWI_SCL_FREQUENCY, use TWI_BIT_RATE_VALUE and TWI_PRESCALER_SELECT in the configuration structure.
  *
  */
 void TWI_Init(TWI_ConfigType *Config_Ptr);
@@ -98,5 +226,48 @@ uint8 TWI_ReadByteWithNACK(void);
  */
 uint8 TWI_GetStatus(void);
 
+/*
+ * Description:
+ * Called by the upper layer when the status is not the expected one:
+ * 1. Count the failure in its class.
+ * 2. Release the bus with a STOP condition (also clears the TWI hardware from a bus error).
+ * 3. After a timeout or a bus error, recover a stuck slave with TWI_BusRecovery.
+ */
+void TWI_HandleError(uint8 Status);
+
+/*
+ * Description:
+ * Recover the bus when a slave holds SDA low (e.g. reset in the middle of a read):
+ * 1. Disable the TWI to get manual control of SCL and SDA pins.
+ * 2. Clock SCL up to nine times until the slave releases SDA.
+ * 3. Generate a STOP condition manually and re-initialize the TWI with the last configuration.
+ */
+void TWI_BusRecovery(void);
+
+/*
+ * Description:
+ * Return the failure counters of the TWI bus.
+ */
+const TWI_ErrorCountersType* TWI_GetErrorCounters(void);
+
+/*
+ * Description:
+ * Answer the own address (TWAR) from the TWI interrupt with a register map, without any polling:
+ * 1. A master write sets the register pointer with its first byte, the next bytes are written from there
+ *    (only the registers from Writable_Start are written, the others are ignored).
+ * 2. A master read returns the registers from the register pointer, which increments after every byte.
+ *    The map is copied when the read is addressed, so a multi-byte register is never read half updated
+ *    as long as the application updates it with the interrupts disabled.
+ * The master functions take the TWI from the interrupt while they own the bus and give it back at the STOP.
+ * The I-bit must be set.
+ */
+void TWI_Slave_Init(volatile uint8 *Registers, uint8 Size, uint8 Writable_Start);
+
+/*
+ * Description:
+ * Function to set the Call Back function called from the TWI interrupt at the end of a master write.
+ */
+void TWI_Slave_SetCallBack(void(*a_ptr)(void));
+
 
 #endif /* I2C_H_ */
@@ -0,0 +1,200 @@
+/*****************************************************************************************************************
+ * File Name: Lockout.c
+ * Date: 18/10/2026
+ * Driver: Persistent Failed Attempts Counter and Lockout Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Common_Macros.h"
+#include "EEPROM.h"
+#include "NVM.h"
+#include "NVM_Layout.h"
+#include "Lockout.h"
+
+STATIC_ASSERT(NVM_ATTEMPTS_RECORD_SIZE == LOCKOUT_RECORD_SIZE, Lockout_Record_Size);
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static uint8 g_Attempts = 0;
+static uint8 g_ElapsedPeriods = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Count the used marks of a group.
+ */
+static uint8 Lockout_CountMarks(const uint8 *Marks, uint8 Number)
+{
+	uint8 Count = 0;
+	uint8 i;
+
+	for (i = 0; i < Number; i++)
+	{
+		if (Marks[i] != LOCKOUT_MARK_ERASED)
+		{
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+/*
+ * Description:
+ * Write one mark (one byte, one write cycle) and wait until it is durable.
+ */
+static uint8 Lockout_WriteMark(uint8 Index)
+{
+	uint8 Mark = LOCKOUT_MARK_USED;
+
+	if (NVM_WriteBlock(NVM_ATTEMPTS_ADDRESS + Index, &Mark, 1) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Sync();
+}
+
+/*
+ * Description:
+ * Erase the whole record with one page write.
+ */
+static uint8 Lockout_Erase(void)
+{
+	uint8 Record[LOCKOUT_RECORD_SIZE];
+	uint8 i;
+
+	for (i = 0; i < LOCKOUT_RECORD_SIZE; i++)
+	{
+		Record[i] = LOCKOUT_MARK_ERASED;
+	}
+
+	/* The counters restart even if the write fails, the stored marks only make the next boot stricter */
+	g_Attempts = 0;
+	g_ElapsedPeriods = 0;
+
+	if (NVM_WriteBlock(NVM_ATTEMPTS_ADDRESS, Record, LOCKOUT_RECORD_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Sync();
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Count the failed attempts and the elapsed lockout periods stored before the last reset (one block read).
+ */
+uint8 Lockout_Init(void)
+{
+	uint8 Record[LOCKOUT_RECORD_SIZE];
+
+	if (NVM_ReadBlock(NVM_ATTEMPTS_ADDRESS, Record, LOCKOUT_RECORD_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	g_Attempts = Lockout_CountMarks(&Record[LOCKOUT_ATTEMPTS_INDEX], LOCKOUT_MAX_ATTEMPTS);
+	g_ElapsedPeriods = Lockout_CountMarks(&Record[LOCKOUT_PERIODS_INDEX], LOCKOUT_PERIODS);
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Persist one more failed attempt. The mark is durable when the function returns, so the result of a wrong
+ * password must be reported only after this call.
+ */
+uint8 Lockout_RecordFailure(void)
+{
+	if (g_Attempts >= LOCKOUT_MAX_ATTEMPTS)
+	{
+		return SUCCESS;
+	}
+
+	if (Lockout_WriteMark(LOCKOUT_ATTEMPTS_INDEX + g_Attempts) == ERROR)
+	{
+		return ERROR;
+	}
+
+	g_Attempts++;
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Return the number of wrong passwords still accepted before the lockout (0 = locked out).
+ */
+uint8 Lockout_GetAttemptsLeft(void)
+{
+	return (uint8)(LOCKOUT_MAX_ATTEMPTS - g_Attempts);
+}
+
+/*
+ * Description:
+ * Return TRUE if the failed attempts reached LOCKOUT_MAX_ATTEMPTS.
+ */
+boolean Lockout_IsActive(void)
+{
+	return (g_Attempts >= LOCKOUT_MAX_ATTEMPTS);
+}
+
+/*
+ * Description:
+ * Return the number of lockout periods still to wait.
+ */
+uint8 Lockout_GetRemainingPeriods(void)
+{
+	if (!Lockout_IsActive())
+	{
+		return 0;
+	}
+
+	return (uint8)(LOCKOUT_PERIODS - g_ElapsedPeriods);
+}
+
+/*
+ * Description:
+ * Persist the end of one lockout period, the record is erased after the last one.
+ */
+uint8 Lockout_RecordPeriodElapsed(void)
+{
+	if (!Lockout_IsActive())
+	{
+		return SUCCESS;
+	}
+
+	if ((g_ElapsedPeriods + 1) >= LOCKOUT_PERIODS)
+	{
+		/* The lockout is over, one page write instead of the last mark */
+		return Lockout_Erase();
+	}
+
+	/* The period is over even if its mark couldn't be written, the lockout can't stall on a storage failure */
+	g_ElapsedPeriods++;
+
+	return Lockout_WriteMark(LOCKOUT_PERIODS_INDEX + g_ElapsedPeriods - 1);
+}
+
+/*
+ * Description:
+ * Forget the failed attempts after a matched password. Costs nothing if there is no failed attempt.
+ */
+uint8 Lockout_Clear(void)
+{
+	if ((g_Attempts == 0) && (g_ElapsedPeriods == 0))
+	{
+		return SUCCESS;
+	}
+
+	return Lockout_Erase();
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************************************************
+ * File Name: Lockout.h
+ * Date: 18/10/2026
+ * Driver: Persistent Failed Attempts Counter and Lockout Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef LOCKOUT_H_
+#define LOCKOUT_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Wrong passwords accepted before the lockout */
+#define LOCKOUT_MAX_ATTEMPTS                 3
+
+/*
+ * The lock has no real-time clock, so the lockout deadline is kept as the number of elapsed lockout periods.
+ * A power cycle during the lockout loses at most the current period.
+ */
+#define LOCKOUT_PERIODS                      4
+
+/*
+ * The lockout record is one page of the ATTEMPTS region, counting in unary:
+ * [0:7] Attempt marks - [8:15] Elapsed lockout period marks
+ * A mark goes from erased (0xFF) to used (0x00) with one byte write, so a failed attempt costs a single write
+ * cycle. The whole page is erased again with one page write only when the lockout ends or the password matches.
+ * A torn mark reads as neither erased nor used and counts as used.
+ */
+#define LOCKOUT_ATTEMPTS_INDEX               0
+#define LOCKOUT_PERIODS_INDEX                8
+#define LOCKOUT_RECORD_SIZE                  16
+
+#define LOCKOUT_MARK_ERASED                  0xFF
+#define LOCKOUT_MARK_USED                    0x00
+
+#if ((LOCKOUT_MAX_ATTEMPTS > 8) || (LOCKOUT_PERIODS > 8))
+
+#error "The lockout record holds up to 8 attempts and 8 lockout periods"
+
+#endif
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Count the failed attempts and the elapsed lockout periods stored before the last reset (one block read).
+ */
+uint8 Lockout_Init(void);
+
+/*
+ * Description:
+ * Persist one more failed attempt. The mark is durable when the function returns, so the result of a wrong
+ * password must be reported only after this call.
+ */
+uint8 Lockout_RecordFailure(void);
+
+/*
+ * Description:
+ * Return the number of wrong passwords still accepted before the lockout (0 = locked out).
+ */
+uint8 Lockout_GetAttemptsLeft(void);
+
+/*
+ * Description:
+ * Return TRUE if the failed attempts reached LOCKOUT_MAX_ATTEMPTS.
+ */
+boolean Lockout_IsActive(void);
+
+/*
+ * Description:
+ * Return the number of lockout periods still to wait.
+ */
+uint8 Lockout_GetRemainingPeriods(void);
+
+/*
+ * Description:
+ * Persist the end of one lockout period, the record is erased after the last one.
+ */
+uint8 Lockout_RecordPeriodElapsed(void);
+
+/*
+ * Description:
+ * Forget the failed attempts after a matched password. Costs nothing if there is no failed attempt.
+ */
+uint8 Lockout_Clear(void);
+
+#endif /* LOCKOUT_H_ */
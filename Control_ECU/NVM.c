@@ -0,0 +1,154 @@
+/*****************************************************************************************************************
+ * File Name: NVM.c
+ * Date: 18/10/2026
+ * Driver: Non-Volatile Memory Interface Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "EEPROM.h"
+#include "NVM.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Backend selected at build time */
+#if (NVM_BACKEND == NVM_BACKEND_24CXX)
+static const NVM_DriverType *const g_NVM_Driver = &NVM_24Cxx_Driver;
+#elif (NVM_BACKEND == NVM_BACKEND_FRAM)
+static const NVM_DriverType *const g_NVM_Driver = &NVM_FRAM_Driver;
+#elif (NVM_BACKEND == NVM_BACKEND_INTERNAL)
+static const NVM_DriverType *const g_NVM_Driver = &NVM_Internal_Driver;
+#elif (NVM_BACKEND == NVM_BACKEND_HOST_FILE)
+static const NVM_DriverType *const g_NVM_Driver = &NVM_HostFile_Driver;
+#endif
+
+/* Copy of the first g_BootCache_Size bytes of the memory, empty outside the boot */
+static uint8 g_BootCache[NVM_BOOT_CACHE_SIZE];
+static uint16 g_BootCache_Size = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Update the cached bytes of a block just written to the memory.
+ */
+static void NVM_BootCache_Update(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	uint16 i;
+
+	for (i = 0; (i < Length) && (((uint32)Address + i) < g_BootCache_Size); i++)
+	{
+		g_BootCache[Address + i] = Data[i];
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Initialize the backend selected by NVM_BACKEND.
+ */
+uint8 NVM_Init(void)
+{
+	return g_NVM_Driver -> Init();
+}
+
+/*
+ * Description:
+ * Read a block of bytes from the selected backend.
+ */
+uint8 NVM_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+	uint16 i;
+
+	if (((uint32)Address + Length) > g_NVM_Driver -> Capabilities.Size)
+	{
+		return ERROR;
+	}
+
+	/* Served from RAM during the boot, no bus transaction */
+	if (((uint32)Address + Length) <= g_BootCache_Size)
+	{
+		for (i = 0; i < Length; i++)
+		{
+			Data[i] = g_BootCache[Address + i];
+		}
+
+		return SUCCESS;
+	}
+
+	return g_NVM_Driver -> ReadBlock(Address, Data, Length);
+}
+
+/*
+ * Description:
+ * Write a block of bytes to the selected backend. Blocks inside one page cost one write cycle.
+ */
+uint8 NVM_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	if (((uint32)Address + Length) > g_NVM_Driver -> Capabilities.Size)
+	{
+		return ERROR;
+	}
+
+	if (g_NVM_Driver -> WriteBlock(Address, Data, Length) == ERROR)
+	{
+		/* The stored bytes are unknown now, the next reads must go to the memory */
+		NVM_BootCache_Release();
+		return ERROR;
+	}
+
+	NVM_BootCache_Update(Address, Data, Length);
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Wait until every written byte is durable (returns immediately on FRAM).
+ */
+uint8 NVM_Sync(void)
+{
+	return g_NVM_Driver -> Sync();
+}
+
+/*
+ * Description:
+ * Return the capabilities of the selected backend.
+ */
+const NVM_CapabilitiesType* NVM_GetCapabilities(void)
+{
+	return &(g_NVM_Driver -> Capabilities);
+}
+
+/*
+ * Description:
+ * Read the first Size bytes of the memory with one sequential read into the boot cache.
+ * Must be called after NVM_Init, returns ERROR if Size is larger than NVM_BOOT_CACHE_SIZE or the read failed.
+ */
+uint8 NVM_BootCache_Load(uint16 Size)
+{
+	NVM_BootCache_Release();
+
+	if ((Size > NVM_BOOT_CACHE_SIZE) || (NVM_ReadBlock(0, g_BootCache, Size) == ERROR))
+	{
+		return ERROR;
+	}
+
+	g_BootCache_Size = Size;
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Drop the boot cache, every read goes to the memory again (the scrubber must see the stored bytes).
+ */
+void NVM_BootCache_Release(void)
+{
+	g_BootCache_Size = 0;
+}
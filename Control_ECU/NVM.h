@@ -0,0 +1,131 @@
+/*****************************************************************************************************************
+ * File Name: NVM.h
+ * Date: 18/10/2026
+ * Driver: Non-Volatile Memory Interface Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "EEPROM.h"
+
+#ifndef NVM_H_
+#define NVM_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* NVM Backends */
+#define NVM_BACKEND_24CXX                    0x01   /* External I2C EEPROM (EEPROM_PART), 10 msec write cycle */
+#define NVM_BACKEND_FRAM                     0x02   /* External I2C FRAM, no write cycle */
+#define NVM_BACKEND_INTERNAL                 0x03   /* ATmega32 internal 1 KB EEPROM */
+#define NVM_BACKEND_HOST_FILE                0x04   /* File on the host machine (simulation and tests) */
+
+/* Storage used by the application, a site fitted with FRAM only changes this selection */
+#ifndef NVM_BACKEND
+#define NVM_BACKEND                          NVM_BACKEND_24CXX
+#endif
+
+#if ((NVM_BACKEND != NVM_BACKEND_24CXX) && (NVM_BACKEND != NVM_BACKEND_FRAM) && \
+	 (NVM_BACKEND != NVM_BACKEND_INTERNAL) && (NVM_BACKEND != NVM_BACKEND_HOST_FILE))
+
+#error "NVM backend should be 24Cxx, FRAM, Internal EEPROM or Host File"
+
+#endif
+
+/*
+ * Boot cache: everything read before the first keypress is fetched with one sequential read of the start of
+ * the memory (NVM_BootCache_Load). Until NVM_BootCache_Release, the reads inside it are served from RAM and
+ * the writes go through to the memory and to the cache. NVM_BOOT_SIZE (NVM_Layout.h) must fit in it.
+ */
+#ifndef NVM_BOOT_CACHE_SIZE
+#define NVM_BOOT_CACHE_SIZE                  80
+#endif
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Wide enough for the largest configured memory (32 bits only beyond 64 KB of external EEPROM) */
+typedef EEPROM_AddressType NVM_AddressType;
+
+typedef struct
+{
+	uint32 Size;               /* Capacity in bytes */
+	uint16 Page_Size;          /* Largest aligned block written in one write cycle (1 = byte by byte, 0 = no pages) */
+	uint8 Write_Cycle_MS;      /* Worst case write cycle time, 0 if writes are durable immediately */
+}NVM_CapabilitiesType;
+
+/*
+ * Every backend provides these operations, all of them return SUCCESS or ERROR:
+ * 1. Init: prepare the backend (the bus driver is initialized by the application).
+ * 2. ReadBlock: read any block of bytes.
+ * 3. WriteBlock: write any block of bytes, split into pages by the backend. It may return while the last
+ *    write cycle is still running, the next access waits for it.
+ * 4. Sync: wait until every written byte is durable.
+ */
+typedef struct
+{
+	uint8 (*Init)(void);
+	uint8 (*ReadBlock)(NVM_AddressType Address, uint8 *Data, uint16 Length);
+	uint8 (*WriteBlock)(NVM_AddressType Address, const uint8 *Data, uint16 Length);
+	uint8 (*Sync)(void);
+	NVM_CapabilitiesType Capabilities;
+}NVM_DriverType;
+
+/*******************************************************************************************
+ *                                      Backends Declaration                               *
+ *******************************************************************************************/
+
+extern const NVM_DriverType NVM_24Cxx_Driver;
+extern const NVM_DriverType NVM_FRAM_Driver;
+extern const NVM_DriverType NVM_Internal_Driver;
+extern const NVM_DriverType NVM_HostFile_Driver;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Initialize the backend selected by NVM_BACKEND.
+ */
+uint8 NVM_Init(void);
+
+/*
+ * Description:
+ * Read a block of bytes from the selected backend.
+ */
+uint8 NVM_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length);
+
+/*
+ * Description:
+ * Write a block of bytes to the selected backend. Blocks inside one page cost one write cycle.
+ */
+uint8 NVM_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length);
+
+/*
+ * Description:
+ * Wait until every written byte is durable (returns immediately on FRAM).
+ */
+uint8 NVM_Sync(void);
+
+/*
+ * Description:
+ * Return the capabilities of the selected backend.
+ */
+const NVM_CapabilitiesType* NVM_GetCapabilities(void);
+
+/*
+ * Description:
+ * Read the first Size bytes of the memory with one sequential read into the boot cache.
+ * Must be called after NVM_Init, returns ERROR if Size is larger than NVM_BOOT_CACHE_SIZE or the read failed.
+ */
+uint8 NVM_BootCache_Load(uint16 Size);
+
+/*
+ * Description:
+ * Drop the boot cache, every read goes to the memory again (the scrubber must see the stored bytes).
+ */
+void NVM_BootCache_Release(void);
+
+#endif /* NVM_H_ */
@@ -0,0 +1,126 @@
+/*****************************************************************************************************************
+ * File Name: NVM_24Cxx.c
+ * Date: 18/10/2026
+ * Driver: NVM Backend for the External 24Cxx I2C EEPROM Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <util/delay.h>
+#include "EEPROM.h"
+#include "NVM.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Acknowledge polling period and limit (twice the maximum write cycle time) */
+#define NVM_24CXX_POLL_INTERVAL_US           100
+#define NVM_24CXX_MAX_POLLS                  ((EEPROM_WRITE_CYCLE_MS * 1000UL * 2UL) / NVM_24CXX_POLL_INTERVAL_US)
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* TRUE while the EEPROM may still be inside the write cycle of the last page */
+static boolean g_WritePending = FALSE;
+
+/* Address of the last written page, only its chip is busy */
+static NVM_AddressType g_PendingAddress = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+static uint8 NVM_24Cxx_Init(void)
+{
+	g_WritePending = FALSE;
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Wait for the end of the write cycle by acknowledge polling instead of a fixed 10 msec delay,
+ * most write cycles finish earlier than the worst case.
+ */
+static uint8 NVM_24Cxx_Sync(void)
+{
+	uint16 polls;
+
+	if (!g_WritePending)
+	{
+		return SUCCESS;
+	}
+
+	for (polls = 0; polls < NVM_24CXX_MAX_POLLS; polls++)
+	{
+		if (EEPROM_IsReady(g_PendingAddress))
+		{
+			g_WritePending = FALSE;
+			return SUCCESS;
+		}
+		_delay_us(NVM_24CXX_POLL_INTERVAL_US);
+	}
+
+	return ERROR;
+}
+
+static uint8 NVM_24Cxx_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+	/* The EEPROM doesn't answer during its write cycle */
+	if (NVM_24Cxx_Sync() == ERROR)
+	{
+		return ERROR;
+	}
+
+	return EEPROM_ReadBlock(Address, Data, Length);
+}
+
+/*
+ * Description:
+ * Split the block at the page boundaries, every page costs one write cycle.
+ */
+static uint8 NVM_24Cxx_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	uint16 chunk;
+
+	while (Length > 0)
+	{
+		/* Bytes left until the end of the current page */
+		chunk = EEPROM_PAGE_SIZE - (Address % EEPROM_PAGE_SIZE);
+		if (chunk > Length)
+		{
+			chunk = Length;
+		}
+
+		if (NVM_24Cxx_Sync() == ERROR)
+		{
+			return ERROR;
+		}
+
+		if (EEPROM_WritePage(Address, Data, (uint8)chunk) == ERROR)
+		{
+			return ERROR;
+		}
+		g_WritePending = TRUE;
+		g_PendingAddress = Address;
+
+		Address += chunk;
+		Data += chunk;
+		Length -= chunk;
+	}
+
+	return SUCCESS;
+}
+
+/****************************************************************************************
+ *                                     Backend Definition                               *
+ ****************************************************************************************/
+
+const NVM_DriverType NVM_24Cxx_Driver =
+{
+	NVM_24Cxx_Init,
+	NVM_24Cxx_ReadBlock,
+	NVM_24Cxx_WriteBlock,
+	NVM_24Cxx_Sync,
+	{EEPROM_TOTAL_SIZE, EEPROM_PAGE_SIZE, EEPROM_WRITE_CYCLE_MS}
+};
@@ -0,0 +1,63 @@
+/*****************************************************************************************************************
+ * File Name: NVM_FRAM.c
+ * Date: 18/10/2026
+ * Driver: NVM Backend for the External I2C FRAM Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "EEPROM.h"
+#include "NVM.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * FRAM pin and protocol compatible with the selected EEPROM_PART (e.g. MB85RC16 for the 24C16, FM24C64 for
+ * the 24C64): same device and memory addressing, no pages and no write cycle, every byte is durable at the ACK.
+ */
+#define NVM_FRAM_SIZE                        EEPROM_TOTAL_SIZE
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+static uint8 NVM_FRAM_Init(void)
+{
+	return SUCCESS;
+}
+
+static uint8 NVM_FRAM_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+	return EEPROM_ReadBlock(Address, Data, Length);
+}
+
+/*
+ * Description:
+ * The whole block goes in one transaction, there is no page to split at.
+ */
+static uint8 NVM_FRAM_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	return EEPROM_WriteBlock(Address, Data, Length);
+}
+
+/*
+ * Description:
+ * Nothing to wait for, zero-wait writes.
+ */
+static uint8 NVM_FRAM_Sync(void)
+{
+	return SUCCESS;
+}
+
+/****************************************************************************************
+ *                                     Backend Definition                               *
+ ****************************************************************************************/
+
+const NVM_DriverType NVM_FRAM_Driver =
+{
+	NVM_FRAM_Init,
+	NVM_FRAM_ReadBlock,
+	NVM_FRAM_WriteBlock,
+	NVM_FRAM_Sync,
+	{NVM_FRAM_SIZE, 0, 0}
+};
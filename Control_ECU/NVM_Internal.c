@@ -0,0 +1,66 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Internal.c
+ * Date: 18/10/2026
+ * Driver: NVM Backend for the ATmega32 Internal EEPROM Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include "EEPROM.h"
+#include "NVM.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* 1 KB written byte by byte, 8.5 msec per byte at the internal calibrated oscillator */
+#define NVM_INTERNAL_SIZE                    (E2END + 1)
+#define NVM_INTERNAL_WRITE_CYCLE_MS          9
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+static uint8 NVM_Internal_Init(void)
+{
+	return SUCCESS;
+}
+
+static uint8 NVM_Internal_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+	eeprom_read_block(Data, (const void *)(uintptr_t)Address, Length);
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Only the bytes that differ are written, so rewriting an unchanged record costs no write cycle.
+ */
+static uint8 NVM_Internal_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	eeprom_update_block(Data, (void *)(uintptr_t)Address, Length);
+
+	return SUCCESS;
+}
+
+static uint8 NVM_Internal_Sync(void)
+{
+	eeprom_busy_wait();
+
+	return SUCCESS;
+}
+
+/****************************************************************************************
+ *                                     Backend Definition                               *
+ ****************************************************************************************/
+
+const NVM_DriverType NVM_Internal_Driver =
+{
+	NVM_Internal_Init,
+	NVM_Internal_ReadBlock,
+	NVM_Internal_WriteBlock,
+	NVM_Internal_Sync,
+	{NVM_INTERNAL_SIZE, 1, NVM_INTERNAL_WRITE_CYCLE_MS}
+};
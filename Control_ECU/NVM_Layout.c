@@ -0,0 +1,257 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Layout.c
+ * Date: 18/10/2026
+ * Driver: Versioned NVM Layout Map Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Common_Macros.h"
+#include "EEPROM.h"
+#include "NVM.h"
+#include "CRC.h"
+#include "Credential.h"
+#include "Watchdog.h"
+#include "NVM_Layout.h"
+
+/* The whole layout must fit in the smallest supported memory (the 1 KB internal EEPROM) below the watchdog record */
+STATIC_ASSERT(NVM_LAYOUT_SIZE <= WATCHDOG_RECORD_ADDRESS, NVM_Layout_Fits_Memory);
+
+/* The boot region is read in one burst into the NVM boot cache */
+STATIC_ASSERT(NVM_BOOT_SIZE <= NVM_BOOT_CACHE_SIZE, NVM_Layout_Boot_Region_Fits_Cache);
+
+/* The credential slots are addressed through the layout */
+STATIC_ASSERT(NVM_CREDENTIAL_RECORD_SIZE == CREDENTIAL_SLOT_SIZE, NVM_Layout_Credential_Slot_Size);
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* A migration step upgrades the stored data from version N to version N + 1 */
+typedef uint8 (*NVM_Layout_MigrationType)(void);
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static uint8 g_StoredVersion = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Version 0 to 1: import the raw PIN of the original firmware into a credential slot.
+ * Credential_Save puts the first record into slot B, the raw PIN at 0x0000 stays readable until it commits.
+ */
+static uint8 NVM_Layout_MigrateV0(void)
+{
+	uint8 Pin[CREDENTIAL_PIN_SIZE];
+	uint8 i;
+
+	if (NVM_ReadBlock(0x0000, Pin, CREDENTIAL_PIN_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < CREDENTIAL_PIN_SIZE; i++)
+	{
+		if (Pin[i] > 9)
+		{
+			/* Erased memory, nothing to import */
+			return SUCCESS;
+		}
+	}
+
+	return Credential_Save(Pin);
+}
+
+/*
+ * Description:
+ * Version 1 to 2: the header is appended after the credential slots, nothing moves.
+ */
+static uint8 NVM_Layout_MigrateV1(void)
+{
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Version 2 to 3: the mirror region is appended (now unused), NVM_Mirror_Init fills both tiers.
+ */
+static uint8 NVM_Layout_MigrateV2(void)
+{
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Version 3 to 4: the attempts counter region starts erased (no failed attempt).
+ */
+static uint8 NVM_Layout_MigrateV3(void)
+{
+	uint8 Record[NVM_ATTEMPTS_RECORD_SIZE];
+	uint8 i;
+
+	for (i = 0; i < NVM_ATTEMPTS_RECORD_SIZE; i++)
+	{
+		Record[i] = 0xFF;
+	}
+
+	if (NVM_WriteBlock(NVM_ATTEMPTS_ADDRESS, Record, NVM_ATTEMPTS_RECORD_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Sync();
+}
+
+/*
+ * Description:
+ * Version 4 to 5: the clear PIN is replaced by its salted digest, the clear PIN (or the raw PIN of version 0
+ * imported into slot B) is wiped.
+ */
+static uint8 NVM_Layout_MigrateV4(void)
+{
+	return Credential_Upgrade();
+}
+
+/* g_Migrations[N] upgrades version N to version N + 1 */
+static const NVM_Layout_MigrationType g_Migrations[NVM_LAYOUT_VERSION] =
+{
+	NVM_Layout_MigrateV0,
+	NVM_Layout_MigrateV1,
+	NVM_Layout_MigrateV2,
+	NVM_Layout_MigrateV3,
+	NVM_Layout_MigrateV4
+};
+
+/*
+ * Description:
+ * Read the stored layout version from the header.
+ * Returns ERROR if the header could not be read, FALSE in Valid if it is erased or corrupted.
+ */
+static uint8 NVM_Layout_ReadHeader(uint8 *Version, boolean *Valid)
+{
+	uint8 Header[NVM_HEADER_RECORD_SIZE];
+
+	if (NVM_ReadBlock(NVM_HEADER_ADDRESS, Header, NVM_HEADER_RECORD_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	*Valid = (Header[NVM_HEADER_MAGIC_INDEX] == NVM_HEADER_MAGIC_0) &&
+			 (Header[NVM_HEADER_MAGIC_INDEX + 1] == NVM_HEADER_MAGIC_1) &&
+			 (CRC8_Calculate(Header, NVM_HEADER_CRC_INDEX) == Header[NVM_HEADER_CRC_INDEX]);
+	*Version = Header[NVM_HEADER_VERSION_INDEX];
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Write the header of the current layout, one page write. This commits a migration.
+ */
+static uint8 NVM_Layout_WriteHeader(void)
+{
+	uint8 Header[NVM_HEADER_RECORD_SIZE];
+	uint8 i;
+
+	for (i = 0; i < NVM_HEADER_RECORD_SIZE; i++)
+	{
+		Header[i] = 0xFF;
+	}
+
+	Header[NVM_HEADER_MAGIC_INDEX] = NVM_HEADER_MAGIC_0;
+	Header[NVM_HEADER_MAGIC_INDEX + 1] = NVM_HEADER_MAGIC_1;
+	Header[NVM_HEADER_VERSION_INDEX] = NVM_LAYOUT_VERSION;
+	Header[NVM_HEADER_CRC_INDEX] = CRC8_Calculate(Header, NVM_HEADER_CRC_INDEX);
+
+	if (NVM_WriteBlock(NVM_HEADER_ADDRESS, Header, NVM_HEADER_RECORD_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Sync();
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Read the layout header and bring the stored data up to NVM_LAYOUT_VERSION, one version at a time.
+ * Without a valid header the stored version is detected from the data (version 1 slots, version 0 raw PIN
+ * or an erased memory). Must be called after NVM_Init and before any other module reads its region.
+ * Returns ERROR if the memory could not be accessed or it holds a layout newer than this firmware.
+ */
+uint8 NVM_Layout_Init(void)
+{
+	uint8 Version;
+	boolean Valid;
+
+	if (NVM_Layout_ReadHeader(&Version, &Valid) == ERROR)
+	{
+		return ERROR;
+	}
+
+	if (!Valid)
+	{
+		/*
+		 * Layouts older than version 2 have no header, a committed clear PIN slot means version 1.
+		 * A digest slot is only written from the version 4 to 5 migration on: a reset before its header,
+		 * the migration runs again to finish wiping the clear PIN.
+		 */
+		if (Credential_Init() == ERROR)
+		{
+			return ERROR;
+		}
+
+		if (Credential_IsStored())
+		{
+			Version = 4;
+		}
+		else
+		{
+			Version = Credential_IsLegacyStored() ? 1 : 0;
+		}
+	}
+
+	g_StoredVersion = Version;
+
+	if (Version == NVM_LAYOUT_VERSION)
+	{
+		return SUCCESS;
+	}
+
+	if (Version > NVM_LAYOUT_VERSION)
+	{
+		/* Written by a newer firmware, leave it untouched */
+		return ERROR;
+	}
+
+	/* The credential module must know the slots of the old layout before any step saves a record */
+	if (Valid && (Credential_Init() == ERROR))
+	{
+		return ERROR;
+	}
+
+	for ( ; Version < NVM_LAYOUT_VERSION; Version++)
+	{
+		if (g_Migrations[Version]() == ERROR)
+		{
+			return ERROR;
+		}
+	}
+
+	return NVM_Layout_WriteHeader();
+}
+
+/*
+ * Description:
+ * Return the layout version found in the memory at boot (before the migration).
+ */
+uint8 NVM_Layout_GetStoredVersion(void)
+{
+	return g_StoredVersion;
+}
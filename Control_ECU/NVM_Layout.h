@@ -0,0 +1,109 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Layout.h
+ * Date: 18/10/2026
+ * Driver: Versioned NVM Layout Map Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef NVM_LAYOUT_H_
+#define NVM_LAYOUT_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Layout history:
+ * Version 0: the original firmware, the PIN digits stored raw at 0x0000.
+ * Version 1: two CRC protected credential slots at 0x0000 and 0x0010, no header.
+ * Version 2: version 1 followed by the layout header.
+ * Version 3: version 2 followed by the mirror stamp, the hot regions are mirrored into the internal EEPROM.
+ * Version 4: version 3 followed by the persistent failed attempts counter.
+ * Version 5: the credential slots hold a salted digest of the PIN instead of the PIN (same slots, new marker).
+ *
+ * Every new version must only write into space the previous version doesn't use and then rewrite the header,
+ * so a power failure during a migration leaves the previous layout intact and the migration runs again.
+ * Version 5 rewrites the credential slots in place, which stays safe because the double buffered slots always
+ * keep one valid record and the two record formats have distinct commit markers.
+ */
+#define NVM_LAYOUT_VERSION                   5
+
+/* Every region starts on a page boundary so a record never straddles two pages */
+#define NVM_LAYOUT_PAGE_SIZE                 16
+#define NVM_LAYOUT_PAGE_ALIGN(SIZE)          ((((SIZE) + NVM_LAYOUT_PAGE_SIZE - 1) / NVM_LAYOUT_PAGE_SIZE) * NVM_LAYOUT_PAGE_SIZE)
+
+/*
+ * The layout map: X(Region Name, Record Size, Record Count, Mirrored)
+ * Regions are placed one after the other in this order, new regions are only added at the end.
+ * Mirrored regions are hot records also kept in the internal EEPROM at the same address (see NVM_Mirror.h).
+ * The attempts counter stays external: it is read once, at boot from the boot region cache (no bus transfer a
+ * mirror would save), then kept in RAM, so a mirror would only add an internal write to every wrong password.
+ * The mirror region held a stamp of the tiers in earlier firmware, it is left unused (the records are compared).
+ */
+#define NVM_LAYOUT_REGIONS(X) \
+	X(CREDENTIAL,  16, 2, TRUE) \
+	X(HEADER,      16, 1, FALSE) \
+	X(MIRROR,      16, 1, FALSE) \
+	X(ATTEMPTS,    16, 1, FALSE)
+
+/*
+ * Boot region: the regions read before the first keypress (credential, header, unused mirror region and
+ * attempts counter) come first, so the boot fetches them with one sequential read (NVM_BootCache_Load).
+ * A region added later and needed at boot must be moved below this bound by a layout version.
+ */
+#define NVM_BOOT_SIZE                        (NVM_ATTEMPTS_END + 1)
+
+/* Layout header: [0:1] Magic - [2] Layout version - [3:14] Reserved - [15] CRC-8 of bytes [0:14] */
+#define NVM_HEADER_MAGIC_0                   'D'
+#define NVM_HEADER_MAGIC_1                   'L'
+#define NVM_HEADER_MAGIC_INDEX               0
+#define NVM_HEADER_VERSION_INDEX             2
+#define NVM_HEADER_CRC_INDEX                 15
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Region addresses: NVM_<Region>_ADDRESS and NVM_<Region>_END (the last byte of the region) */
+#define NVM_LAYOUT_OFFSETS(NAME, RECORD_SIZE, RECORD_COUNT, MIRRORED) \
+	NVM_##NAME##_ADDRESS, \
+	NVM_##NAME##_END = NVM_##NAME##_ADDRESS + NVM_LAYOUT_PAGE_ALIGN((RECORD_SIZE) * (RECORD_COUNT)) - 1,
+
+enum
+{
+	NVM_LAYOUT_REGIONS(NVM_LAYOUT_OFFSETS)
+	NVM_LAYOUT_SIZE
+};
+
+/* Region records: NVM_<Region>_RECORD_SIZE and NVM_<Region>_RECORD_COUNT */
+#define NVM_LAYOUT_RECORDS(NAME, RECORD_SIZE, RECORD_COUNT, MIRRORED) \
+	NVM_##NAME##_RECORD_SIZE = (RECORD_SIZE), \
+	NVM_##NAME##_RECORD_COUNT = (RECORD_COUNT),
+
+enum
+{
+	NVM_LAYOUT_REGIONS(NVM_LAYOUT_RECORDS)
+	NVM_LAYOUT_RECORDS_END
+};
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Read the layout header and bring the stored data up to NVM_LAYOUT_VERSION, one version at a time.
+ * Without a valid header the stored version is detected from the data (version 1 slots, version 0 raw PIN
+ * or an erased memory). Must be called after NVM_Init and before any other module reads its region.
+ * Returns ERROR if the memory could not be accessed or it holds a layout newer than this firmware.
+ */
+uint8 NVM_Layout_Init(void);
+
+/*
+ * Description:
+ * Return the layout version found in the memory at boot (before the migration).
+ */
+uint8 NVM_Layout_GetStoredVersion(void);
+
+#endif /* NVM_LAYOUT_H_ */
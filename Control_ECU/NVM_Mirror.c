@@ -0,0 +1,231 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Mirror.c
+ * Date: 18/10/2026
+ * Driver: Internal EEPROM Mirror Tier Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "EEPROM.h"
+#include "NVM.h"
+#include "NVM_Layout.h"
+#include "NVM_Mirror.h"
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	NVM_AddressType Address;
+	NVM_AddressType End;
+	boolean Mirrored;
+}NVM_Mirror_RegionType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static NVM_Mirror_StateType g_State = NVM_MIRROR_UNKNOWN;
+
+#if (NVM_MIRROR_ENABLE == TRUE)
+
+#define NVM_MIRROR_REGION(NAME, RECORD_SIZE, RECORD_COUNT, MIRRORED) \
+	{NVM_##NAME##_ADDRESS, NVM_##NAME##_END, MIRRORED},
+
+static const NVM_Mirror_RegionType g_Regions[] =
+{
+	NVM_LAYOUT_REGIONS(NVM_MIRROR_REGION)
+};
+
+#define NVM_MIRROR_REGIONS_NUMBER            (sizeof(g_Regions) / sizeof(g_Regions[0]))
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return TRUE if the whole block is inside one hot region.
+ */
+static boolean NVM_Mirror_IsHot(NVM_AddressType Address, uint16 Length)
+{
+	uint8 i;
+
+	for (i = 0; i < NVM_MIRROR_REGIONS_NUMBER; i++)
+	{
+		if ((g_Regions[i].Mirrored) && (Address >= g_Regions[i].Address) &&
+			(((uint32)Address + Length - 1) <= g_Regions[i].End))
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/*
+ * Description:
+ * Compare every hot region of the two tiers one page at a time, and copy the pages that differ from the external
+ * memory into the internal EEPROM. A reset in the middle of the copy leaves the tiers different, the next boot
+ * copies them again.
+ */
+static uint8 NVM_Mirror_Resynchronize(void)
+{
+	uint8 External[NVM_LAYOUT_PAGE_SIZE];
+	uint8 Internal[NVM_LAYOUT_PAGE_SIZE];
+	NVM_AddressType Address;
+	uint8 i;
+	uint8 j;
+
+	for (i = 0; i < NVM_MIRROR_REGIONS_NUMBER; i++)
+	{
+		if (!g_Regions[i].Mirrored)
+		{
+			continue;
+		}
+
+		/* Region by region, one page at a time (the regions are page aligned) */
+		for (Address = g_Regions[i].Address; Address < g_Regions[i].End; Address += NVM_LAYOUT_PAGE_SIZE)
+		{
+			if ((NVM_ReadBlock(Address, External, NVM_LAYOUT_PAGE_SIZE) == ERROR) ||
+				(NVM_Internal_Driver.ReadBlock(Address, Internal, NVM_LAYOUT_PAGE_SIZE) == ERROR))
+			{
+				return ERROR;
+			}
+
+			for (j = 0; (j < NVM_LAYOUT_PAGE_SIZE) && (External[j] == Internal[j]); j++)
+			{
+			}
+
+			if ((j < NVM_LAYOUT_PAGE_SIZE) &&
+				(NVM_Internal_Driver.WriteBlock(Address, External, NVM_LAYOUT_PAGE_SIZE) == ERROR))
+			{
+				return ERROR;
+			}
+		}
+	}
+
+	return NVM_Internal_Driver.Sync();
+}
+
+#endif
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Compare the hot regions of the two tiers and copy them from the external memory if they differ. Must be
+ * called after NVM_Layout_Init, until then every access goes to the external memory.
+ */
+uint8 NVM_Mirror_Init(void)
+{
+#if (NVM_MIRROR_ENABLE == TRUE)
+	g_State = NVM_MIRROR_UNKNOWN;
+
+	/* A migration writes the external memory only, the tiers differ after one */
+	if (NVM_Mirror_Resynchronize() == ERROR)
+	{
+		return ERROR;
+	}
+
+	g_State = NVM_MIRROR_CONSISTENT;
+#endif
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Read a block of bytes, from the internal EEPROM if the block is inside a hot region and the mirror is
+ * consistent, else from the external memory.
+ */
+uint8 NVM_Mirror_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+#if (NVM_MIRROR_ENABLE == TRUE)
+	if ((g_State == NVM_MIRROR_CONSISTENT) && NVM_Mirror_IsHot(Address, Length))
+	{
+		return NVM_Internal_Driver.ReadBlock(Address, Data, Length);
+	}
+#endif
+
+	return NVM_ReadBlock(Address, Data, Length);
+}
+
+/*
+ * Description:
+ * Write a block of bytes to the external memory, and to the internal EEPROM too if it is inside a hot region.
+ */
+uint8 NVM_Mirror_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+#if (NVM_MIRROR_ENABLE == TRUE)
+	if ((g_State == NVM_MIRROR_UNKNOWN) || (g_State == NVM_MIRROR_STALE) || !NVM_Mirror_IsHot(Address, Length))
+	{
+		return NVM_WriteBlock(Address, Data, Length);
+	}
+
+	/* The internal copy isn't read until NVM_Mirror_Sync, the writes of both tiers may be pending until then */
+	g_State = NVM_MIRROR_DIRTY;
+
+	if (NVM_WriteBlock(Address, Data, Length) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return NVM_Internal_Driver.WriteBlock(Address, Data, Length);
+#else
+	return NVM_WriteBlock(Address, Data, Length);
+#endif
+}
+
+/*
+ * Description:
+ * Wait until every written byte is durable in both tiers, then read the internal EEPROM again.
+ */
+uint8 NVM_Mirror_Sync(void)
+{
+	if (NVM_Sync() == ERROR)
+	{
+		return ERROR;
+	}
+
+#if (NVM_MIRROR_ENABLE == TRUE)
+	if (g_State == NVM_MIRROR_DIRTY)
+	{
+		if (NVM_Internal_Driver.Sync() == ERROR)
+		{
+			return ERROR;
+		}
+
+		g_State = NVM_MIRROR_CONSISTENT;
+	}
+#endif
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Drop the internal copy after it failed a check the external copy passed: read the external memory until the
+ * next boot, which finds the tiers different and copies the hot regions again.
+ */
+uint8 NVM_Mirror_Invalidate(void)
+{
+#if (NVM_MIRROR_ENABLE == TRUE)
+	if (g_State != NVM_MIRROR_UNKNOWN)
+	{
+		g_State = NVM_MIRROR_STALE;
+	}
+#endif
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Return the state of the mirror.
+ */
+NVM_Mirror_StateType NVM_Mirror_GetState(void)
+{
+	return g_State;
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Mirror.h
+ * Date: 18/10/2026
+ * Driver: Internal EEPROM Mirror Tier Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "NVM.h"
+
+#ifndef NVM_MIRROR_H_
+#define NVM_MIRROR_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The hot regions of the layout (Mirrored = TRUE) are copied into the ATmega32 internal EEPROM at the same
+ * addresses, so reading them doesn't need the I2C bus. The external memory stays the authoritative copy.
+ * The internal EEPROM is the primary store itself when NVM_BACKEND is NVM_BACKEND_INTERNAL, nothing to mirror.
+ */
+#ifndef NVM_MIRROR_ENABLE
+#if ((NVM_BACKEND == NVM_BACKEND_24CXX) || (NVM_BACKEND == NVM_BACKEND_FRAM))
+#define NVM_MIRROR_ENABLE                    TRUE
+#else
+#define NVM_MIRROR_ENABLE                    FALSE
+#endif
+#endif
+
+/*
+ * The hot records carry their own sequence number and commit marker (the credential slots), so no stamp is
+ * written beside them: the mirror is consistent at boot when the hot regions of both tiers are equal, a reset
+ * between the writes of the two tiers leaves a record (its sequence number or its commit marker) different.
+ * The hot regions are inside the boot region, the external side of the comparison costs no bus transfer.
+ */
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef enum
+{
+	/* STALE: the internal copy failed a check, every access goes to the external memory until the next boot */
+	NVM_MIRROR_UNKNOWN, NVM_MIRROR_CONSISTENT, NVM_MIRROR_DIRTY, NVM_MIRROR_STALE
+}NVM_Mirror_StateType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Compare the hot regions of the two tiers and copy them from the external memory if they differ. Must be
+ * called after NVM_Layout_Init, until then every access goes to the external memory.
+ */
+uint8 NVM_Mirror_Init(void);
+
+/*
+ * Description:
+ * Read a block of bytes, from the internal EEPROM if the block is inside a hot region and the mirror is
+ * consistent, else from the external memory.
+ */
+uint8 NVM_Mirror_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length);
+
+/*
+ * Description:
+ * Write a block of bytes to the external memory, and to the internal EEPROM too if it is inside a hot region.
+ */
+uint8 NVM_Mirror_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length);
+
+/*
+ * Description:
+ * Wait until every written byte is durable in both tiers, then read the internal EEPROM again.
+ * The writes of one update (e.g. a record page then its commit byte) are ordered with NVM_Sync alone, which
+ * leaves the mirror dirty, and closed by one NVM_Mirror_Sync.
+ */
+uint8 NVM_Mirror_Sync(void);
+
+/*
+ * Description:
+ * Drop the internal copy after it failed a check the external copy passed: read the external memory until the
+ * next boot, which finds the tiers different and copies the hot regions again.
+ */
+uint8 NVM_Mirror_Invalidate(void);
+
+/*
+ * Description:
+ * Return the state of the mirror.
+ */
+NVM_Mirror_StateType NVM_Mirror_GetState(void);
+
+#endif /* NVM_MIRROR_H_ */
@@ -0,0 +1,285 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Scrub.c
+ * Date: 18/10/2026
+ * Driver: Background NVM Integrity Scrubber Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Common_Macros.h"
+#include "EEPROM.h"
+#include "NVM.h"
+#include "NVM_Layout.h"
+#include "NVM_Mirror.h"
+#include "CRC.h"
+#include "Credential.h"
+#include "NVM_Scrub.h"
+
+STATIC_ASSERT(NVM_CREDENTIAL_RECORD_SIZE == NVM_SCRUB_BLOCK_SIZE, Scrub_Credential_Block);
+STATIC_ASSERT(NVM_HEADER_RECORD_SIZE == NVM_SCRUB_BLOCK_SIZE, Scrub_Header_Block);
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Grades of a record, the copy with the higher grade wins when the two tiers disagree */
+#define NVM_SCRUB_RECORD_CORRUPTED           0
+#define NVM_SCRUB_RECORD_EMPTY               1
+#define NVM_SCRUB_RECORD_VALID               2
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	NVM_AddressType Address;
+	NVM_AddressType End;
+	boolean Mirrored;
+}NVM_Scrub_RegionType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+#define NVM_SCRUB_REGION(NAME, RECORD_SIZE, RECORD_COUNT, MIRRORED) \
+	{NVM_##NAME##_ADDRESS, NVM_##NAME##_END, MIRRORED},
+
+static const NVM_Scrub_RegionType g_Regions[] =
+{
+	NVM_LAYOUT_REGIONS(NVM_SCRUB_REGION)
+};
+
+#define NVM_SCRUB_REGIONS_NUMBER             (sizeof(g_Regions) / sizeof(g_Regions[0]))
+
+/* Next block to verify */
+static NVM_AddressType g_NextAddress = 0;
+
+/* One bit per block found corrupted and not repaired */
+static uint8 g_Corrupted[(NVM_SCRUB_BLOCKS_NUMBER + 7) / 8];
+
+static NVM_Scrub_StatisticsType g_Statistics;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * A credential slot is corrupted only if it is committed with a wrong CRC, an uncommitted slot is a
+ * normal state (never written, or a save interrupted before its commit marker).
+ */
+static uint8 NVM_Scrub_GradeCredential(const uint8 *Block)
+{
+	if (Block[CREDENTIAL_COMMIT_INDEX] != CREDENTIAL_COMMITTED)
+	{
+		return NVM_SCRUB_RECORD_EMPTY;
+	}
+
+	if (CRC8_Calculate(Block, CREDENTIAL_CRC_INDEX) != Block[CREDENTIAL_CRC_INDEX])
+	{
+		return NVM_SCRUB_RECORD_CORRUPTED;
+	}
+
+	return NVM_SCRUB_RECORD_VALID;
+}
+
+/*
+ * Description:
+ * The layout header is always written once NVM_Layout_Init returns, it must be valid.
+ */
+static uint8 NVM_Scrub_GradeHeader(const uint8 *Block)
+{
+	if ((Block[NVM_HEADER_MAGIC_INDEX] != NVM_HEADER_MAGIC_0) ||
+		(Block[NVM_HEADER_MAGIC_INDEX + 1] != NVM_HEADER_MAGIC_1) ||
+		(CRC8_Calculate(Block, NVM_HEADER_CRC_INDEX) != Block[NVM_HEADER_CRC_INDEX]))
+	{
+		return NVM_SCRUB_RECORD_CORRUPTED;
+	}
+
+	return NVM_SCRUB_RECORD_VALID;
+}
+
+/*
+ * Description:
+ * Grade a block with the record format of its region, a region without CRC is always intact.
+ */
+static uint8 NVM_Scrub_Grade(NVM_AddressType Address, const uint8 *Block)
+{
+	if ((Address >= NVM_CREDENTIAL_ADDRESS) && (Address <= NVM_CREDENTIAL_END))
+	{
+		return NVM_Scrub_GradeCredential(Block);
+	}
+
+	if ((Address >= NVM_HEADER_ADDRESS) && (Address <= NVM_HEADER_END))
+	{
+		return NVM_Scrub_GradeHeader(Block);
+	}
+
+	return NVM_SCRUB_RECORD_EMPTY;
+}
+
+/*
+ * Description:
+ * Return TRUE if the block is inside a mirrored region.
+ */
+static boolean NVM_Scrub_IsMirrored(NVM_AddressType Address)
+{
+	uint8 i;
+
+	for (i = 0; i < NVM_SCRUB_REGIONS_NUMBER; i++)
+	{
+		if ((g_Regions[i].Mirrored) && (Address >= g_Regions[i].Address) && (Address <= g_Regions[i].End))
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/*
+ * Description:
+ * Mark the block as corrupted or intact, return the result of the step.
+ */
+static NVM_Scrub_ResultType NVM_Scrub_Mark(NVM_AddressType Address, boolean Corrupted)
+{
+	uint16 Block = (uint16)(Address / NVM_SCRUB_BLOCK_SIZE);
+
+	if (!Corrupted)
+	{
+		CLEAR_BIT(g_Corrupted[Block / 8], Block % 8);
+		return NVM_SCRUB_INTACT;
+	}
+
+	if (BIT_IS_SET(g_Corrupted[Block / 8], Block % 8))
+	{
+		return NVM_SCRUB_STILL_CORRUPTED;
+	}
+
+	SET_BIT(g_Corrupted[Block / 8], Block % 8);
+	g_Statistics.Corruptions++;
+
+	return NVM_SCRUB_CORRUPTED;
+}
+
+/*
+ * Description:
+ * Compare the two copies of a mirrored block and rewrite both tiers from the better one if they differ.
+ * The repair goes through the mirror write protocol, so a reset in the middle is recovered at the next boot.
+ */
+static NVM_Scrub_ResultType NVM_Scrub_CheckMirrored(NVM_AddressType Address, const uint8 *External)
+{
+	uint8 Internal[NVM_SCRUB_BLOCK_SIZE];
+	uint8 External_Grade;
+	uint8 Internal_Grade;
+	const uint8 *Source;
+	boolean Equal = TRUE;
+	uint8 i;
+
+	if (NVM_Internal_Driver.ReadBlock(Address, Internal, NVM_SCRUB_BLOCK_SIZE) == ERROR)
+	{
+		g_Statistics.Access_Errors++;
+		return NVM_SCRUB_ACCESS_ERROR;
+	}
+
+	for (i = 0; i < NVM_SCRUB_BLOCK_SIZE; i++)
+	{
+		if (External[i] != Internal[i])
+		{
+			Equal = FALSE;
+		}
+	}
+
+	External_Grade = NVM_Scrub_Grade(Address, External);
+
+	if (Equal)
+	{
+		/* Both copies carry the same damage, nothing to repair from */
+		return NVM_Scrub_Mark(Address, (External_Grade == NVM_SCRUB_RECORD_CORRUPTED));
+	}
+
+	Internal_Grade = NVM_Scrub_Grade(Address, Internal);
+
+	if ((External_Grade == NVM_SCRUB_RECORD_CORRUPTED) && (Internal_Grade == NVM_SCRUB_RECORD_CORRUPTED))
+	{
+		return NVM_Scrub_Mark(Address, TRUE);
+	}
+
+	/* The external memory is the authoritative copy unless its grade is lower */
+	Source = (Internal_Grade > External_Grade) ? Internal : External;
+
+	g_Statistics.Corruptions++;
+
+	if ((NVM_Mirror_WriteBlock(Address, Source, NVM_SCRUB_BLOCK_SIZE) == ERROR) || (NVM_Mirror_Sync() == ERROR))
+	{
+		g_Statistics.Access_Errors++;
+		return NVM_SCRUB_ACCESS_ERROR;
+	}
+
+	g_Statistics.Repairs++;
+	NVM_Scrub_Mark(Address, FALSE);
+
+	return NVM_SCRUB_REPAIRED;
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Verify the next block and repair it from the other tier if it is mirrored, then move to the next block.
+ * Call it only while the controller is idle, it returns after at most one block.
+ */
+NVM_Scrub_ResultType NVM_Scrub_Step(void)
+{
+	uint8 External[NVM_SCRUB_BLOCK_SIZE];
+	NVM_AddressType Address = g_NextAddress;
+
+	g_NextAddress += NVM_SCRUB_BLOCK_SIZE;
+	if (g_NextAddress >= NVM_LAYOUT_SIZE)
+	{
+		g_NextAddress = 0;
+		g_Statistics.Passes++;
+	}
+
+	if (NVM_ReadBlock(Address, External, NVM_SCRUB_BLOCK_SIZE) == ERROR)
+	{
+		g_Statistics.Access_Errors++;
+		return NVM_SCRUB_ACCESS_ERROR;
+	}
+
+	g_Statistics.Blocks_Checked++;
+
+	/* The internal copy is only comparable while the mirror is consistent (never between a write and its sync) */
+	if ((NVM_Mirror_GetState() == NVM_MIRROR_CONSISTENT) && NVM_Scrub_IsMirrored(Address))
+	{
+		return NVM_Scrub_CheckMirrored(Address, External);
+	}
+
+	return NVM_Scrub_Mark(Address, (NVM_Scrub_Grade(Address, External) == NVM_SCRUB_RECORD_CORRUPTED));
+}
+
+/*
+ * Description:
+ * Return TRUE if the block holding the address was found corrupted and couldn't be repaired.
+ */
+boolean NVM_Scrub_IsCorrupted(NVM_AddressType Address)
+{
+	uint16 Block = (uint16)(Address / NVM_SCRUB_BLOCK_SIZE);
+
+	if (Block >= NVM_SCRUB_BLOCKS_NUMBER)
+	{
+		return FALSE;
+	}
+
+	return BIT_IS_SET(g_Corrupted[Block / 8], Block % 8) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Return the scrubber statistics since the last reset.
+ */
+const NVM_Scrub_StatisticsType* NVM_Scrub_GetStatistics(void)
+{
+	return &g_Statistics;
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************************************************
+ * File Name: NVM_Scrub.h
+ * Date: 18/10/2026
+ * Driver: Background NVM Integrity Scrubber Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "NVM.h"
+#include "NVM_Layout.h"
+
+#ifndef NVM_SCRUB_H_
+#define NVM_SCRUB_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The scrubber walks the layout one block (one page, one record) per step with a single sequential read.
+ * An intact block costs one external and one internal block read (about 1 msec at 400 kHz), a repair adds
+ * the write cycles of one mirrored write (about 15 msec on a 24Cxx).
+ */
+#define NVM_SCRUB_BLOCK_SIZE                 NVM_LAYOUT_PAGE_SIZE
+#define NVM_SCRUB_BLOCKS_NUMBER              (NVM_LAYOUT_SIZE / NVM_SCRUB_BLOCK_SIZE)
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef enum
+{
+	NVM_SCRUB_INTACT,           /* the block is intact */
+	NVM_SCRUB_REPAIRED,         /* one copy was corrupted and was rewritten from the other one */
+	NVM_SCRUB_CORRUPTED,        /* the block was just found corrupted and can't be repaired */
+	NVM_SCRUB_STILL_CORRUPTED,  /* the block was already known as corrupted */
+	NVM_SCRUB_ACCESS_ERROR      /* the block couldn't be read or repaired, it is checked again next pass */
+}NVM_Scrub_ResultType;
+
+typedef struct
+{
+	uint16 Passes;             /* complete walks through the layout */
+	uint16 Blocks_Checked;
+	uint16 Corruptions;        /* blocks found corrupted (repaired or not) */
+	uint16 Repairs;
+	uint16 Access_Errors;
+}NVM_Scrub_StatisticsType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Verify the next block and repair it from the other tier if it is mirrored, then move to the next block.
+ * Call it only while the controller is idle, it returns after at most one block.
+ */
+NVM_Scrub_ResultType NVM_Scrub_Step(void);
+
+/*
+ * Description:
+ * Return TRUE if the block holding the address was found corrupted and couldn't be repaired.
+ */
+boolean NVM_Scrub_IsCorrupted(NVM_AddressType Address);
+
+/*
+ * Description:
+ * Return the scrubber statistics since the last reset.
+ */
+const NVM_Scrub_StatisticsType* NVM_Scrub_GetStatistics(void);
+
+#endif /* NVM_SCRUB_H_ */
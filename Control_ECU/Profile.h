@@ -0,0 +1,93 @@
+/*****************************************************************************************************************
+ * File Name: Profile.h
+ * Date: 18/10/2026
+ * Driver: Function Profiling Service Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Profiling build: define PROFILE_ENABLE for both ECUs (-DPROFILE_ENABLE). The profiled functions record
+ * their duration in CPU cycles: count, min, max, mean and a log2 histogram. Without PROFILE_ENABLE the hooks
+ * are empty and the service is not compiled. The hooks are for the main loop only, not for the interrupts.
+ */
+#ifdef PROFILE_ENABLE
+
+#define PROFILE_ENTER(ID)                    Profile_Enter(ID)
+#define PROFILE_EXIT(ID)                     Profile_Exit(ID)
+
+#else
+
+#define PROFILE_ENTER(ID)
+#define PROFILE_EXIT(ID)
+
+#endif
+
+/* Bin 0 counts the durations below 2^(FIRST_BIT + 1) cycles, the last bin the ones from 2^(FIRST_BIT + BINS - 1) */
+#define PROFILE_HISTOGRAM_BINS               16
+#define PROFILE_HISTOGRAM_FIRST_BIT          6
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Profiled functions, the same numbers in both ECUs (a function of the other ECU stays empty) */
+typedef enum
+{
+	PROFILE_LCD_DISPLAY_CHARACTER, PROFILE_KEYPAD_GET_PRESSED_KEY, PROFILE_KEYPAD_SCAN,
+	PROFILE_EEPROM_READ_BLOCK, PROFILE_UART_SEND_BYTE, PROFILE_CHECK_PASSWORD, PROFILE_IDS_NUMBER
+}Profile_IdType;
+
+typedef struct
+{
+	uint16 Count;                                  /* saturated at 0xFFFF */
+	uint32 Min;
+	uint32 Max;
+	uint64 Sum;
+	uint16 Histogram[PROFILE_HISTOGRAM_BINS];      /* saturated at 0xFFFF */
+}Profile_EntryType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Clear the table and take the time from Clock, which returns counts of 2^Cycles_Shift CPU cycles
+ * (Timer0_GetTimestamp with shift 0, Tick_NowCounts with TICK_COUNT_CYCLES_SHIFT).
+ */
+void Profile_Init(uint32 (*Clock)(void), uint8 Cycles_Shift);
+
+/*
+ * Description:
+ * Record the entry time of a profiled function.
+ */
+void Profile_Enter(Profile_IdType Id);
+
+/*
+ * Description:
+ * Add the duration since the entry of a profiled function to its entry of the table.
+ */
+void Profile_Exit(Profile_IdType Id);
+
+/*
+ * Description:
+ * Return the entry of the table of a profiled function.
+ */
+const Profile_EntryType* Profile_GetEntry(Profile_IdType Id);
+
+/*
+ * Description:
+ * Send the table as text lines through Send (UART_SendByte), one line per function called at least once:
+ * "id count min max mean: histogram bins", in CPU cycles. The functions called by Send are not recorded.
+ */
+void Profile_Dump(void (*Send)(uint8 Byte));
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,248 @@
+/*****************************************************************************************************************
+ * File Name: Supervisor.c
+ * Date: 18/10/2026
+ * Driver: I2C Register Map for the Building Supervisor Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <util/atomic.h>
+#include "I2C.h"
+#include "Lockout.h"
+#include "Credential.h"
+#include "Tick.h"
+#include "Supervisor.h"
+
+#if (SUPERVISOR_REGISTERS_NUMBER > TWI_SLAVE_MAX_REGISTERS)
+
+#error "The supervisor register map doesn't fit in TWI_SLAVE_MAX_REGISTERS"
+
+#endif
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Read by the TWI interrupt at any time, written by the supervisor from SUPERVISOR_REG_CONFIG_START */
+static volatile uint8 g_Registers[SUPERVISOR_REGISTERS_NUMBER];
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Increment a 16-bit register, saturated at 0xFFFF. The caller disables the interrupts.
+ */
+static void Supervisor_IncrementCounter(uint8 Register)
+{
+	uint16 Value = (uint16)g_Registers[Register] | ((uint16)g_Registers[Register + 1] << 8);
+
+	if (Value != 0xFFFF)
+	{
+		Value++;
+	}
+
+	g_Registers[Register] = (uint8)Value;
+	g_Registers[Register + 1] = (uint8)(Value >> 8);
+}
+
+/*
+ * Description:
+ * Write a 16-bit register. The caller disables the interrupts.
+ */
+static void Supervisor_Write16(uint8 Register, uint16 Value)
+{
+	g_Registers[Register] = (uint8)Value;
+	g_Registers[Register + 1] = (uint8)(Value >> 8);
+}
+
+/*
+ * Description:
+ * Convert Tick counts to msec saturated at 0xFFFF.
+ */
+static uint16 Supervisor_CountsToMs(uint32 Counts)
+{
+	Counts /= TICK_COUNTS_PER_MS;
+
+	return (Counts > 0xFFFF) ? 0xFFFF : (uint16)Counts;
+}
+
+/*
+ * Description:
+ * Called from the TWI interrupt after a supervisor write, the out of range values fall back to the defaults.
+ */
+static void Supervisor_ConfigWritten(void)
+{
+	if ((g_Registers[SUPERVISOR_REG_MOTOR_SPEED] == 0) || (g_Registers[SUPERVISOR_REG_MOTOR_SPEED] > 100))
+	{
+		g_Registers[SUPERVISOR_REG_MOTOR_SPEED] = SUPERVISOR_DEFAULT_MOTOR_SPEED;
+	}
+
+	if (g_Registers[SUPERVISOR_REG_ALARM_ENABLE] > TRUE)
+	{
+		g_Registers[SUPERVISOR_REG_ALARM_ENABLE] = SUPERVISOR_DEFAULT_ALARM_ENABLE;
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Fill the register map with the lockout state and the default configuration, then serve it in TWI slave
+ * mode. Must be called after TWI_Init, Lockout_Init and the PIN hash calibration with the I-bit set.
+ */
+void Supervisor_Init(void)
+{
+	uint32 Hash_Cycles = Credential_GetIterationCycles();
+	uint8 i;
+
+	for (i = 0; i < SUPERVISOR_REGISTERS_NUMBER; i++)
+	{
+		g_Registers[i] = 0;
+	}
+
+	g_Registers[SUPERVISOR_REG_ID] = SUPERVISOR_DEVICE_ID;
+	g_Registers[SUPERVISOR_REG_VERSION] = SUPERVISOR_MAP_VERSION;
+	g_Registers[SUPERVISOR_REG_DOOR_STATE] = Lockout_IsActive() ? SUPERVISOR_DOOR_LOCKED_OUT : SUPERVISOR_DOOR_CLOSED;
+	g_Registers[SUPERVISOR_REG_LAST_EVENT] = SUPERVISOR_EVENT_NONE;
+	Supervisor_RefreshLockout();
+
+	/* In units of 16 cycles: a benchmark within one Timer1 overflow measures 131070 cycles at most */
+	Hash_Cycles /= SUPERVISOR_HASH_CYCLES_UNIT;
+	g_Registers[SUPERVISOR_REG_HASH_CYCLES] = (uint8)Hash_Cycles;
+	g_Registers[SUPERVISOR_REG_HASH_CYCLES + 1] = (uint8)(Hash_Cycles >> 8);
+	g_Registers[SUPERVISOR_REG_MOTOR_SPEED] = SUPERVISOR_DEFAULT_MOTOR_SPEED;
+	g_Registers[SUPERVISOR_REG_ALARM_ENABLE] = SUPERVISOR_DEFAULT_ALARM_ENABLE;
+
+	TWI_Slave_SetCallBack(Supervisor_ConfigWritten);
+	TWI_Slave_Init(g_Registers, SUPERVISOR_REGISTERS_NUMBER, SUPERVISOR_REG_CONFIG_START);
+}
+
+/*
+ * Description:
+ * Publish the time taken to bring the storage up at boot (saturated at 0xFFFF msec).
+ */
+void Supervisor_SetBootTime(uint16 Milliseconds)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_Registers[SUPERVISOR_REG_BOOT_TIME] = (uint8)Milliseconds;
+		g_Registers[SUPERVISOR_REG_BOOT_TIME + 1] = (uint8)(Milliseconds >> 8);
+	}
+}
+
+/*
+ * Description:
+ * Publish the estimated current of the controller in uA while idle, while the door moves and during the lockout.
+ */
+void Supervisor_SetCurrents(uint16 Idle, uint16 Door, uint16 Lockout)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Supervisor_Write16(SUPERVISOR_REG_IDLE_CURRENT, Idle);
+		Supervisor_Write16(SUPERVISOR_REG_DOOR_CURRENT, Door);
+		Supervisor_Write16(SUPERVISOR_REG_LOCKOUT_CURRENT, Lockout);
+	}
+}
+
+/*
+ * Description:
+ * Publish the scheduler latency monitor statistics.
+ */
+void Supervisor_SetLatencies(const Scheduler_StatisticsType *Statistics)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Supervisor_Write16(SUPERVISOR_REG_MAX_RUN, Supervisor_CountsToMs(Statistics -> Max_Run));
+		Supervisor_Write16(SUPERVISOR_REG_MAX_LATENCY, Supervisor_CountsToMs(Statistics -> Max_Latency));
+		Supervisor_Write16(SUPERVISOR_REG_LATE_EVENTS, Statistics -> Late_Events);
+		Supervisor_Write16(SUPERVISOR_REG_OVERRUNS, Statistics -> Overruns);
+		g_Registers[SUPERVISOR_REG_OVERRUN_STATE] = Statistics -> Overrun_State;
+		g_Registers[SUPERVISOR_REG_OVERRUN_EVENT] = Statistics -> Overrun_Event;
+		Supervisor_Write16(SUPERVISOR_REG_OVERRUN_TIME, Supervisor_CountsToMs(Statistics -> Overrun_Time));
+	}
+}
+
+/*
+ * Description:
+ * Publish the watchdog resets and the step stuck at the last one.
+ */
+void Supervisor_SetWatchdog(uint16 Resets, uint8 Stage)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Supervisor_Write16(SUPERVISOR_REG_WATCHDOG_RESETS, Resets);
+		g_Registers[SUPERVISOR_REG_WATCHDOG_STAGE] = Stage;
+	}
+}
+
+/*
+ * Description:
+ * Publish the door state.
+ */
+void Supervisor_SetDoorState(Supervisor_DoorStateType State)
+{
+	g_Registers[SUPERVISOR_REG_DOOR_STATE] = State;
+}
+
+/*
+ * Description:
+ * Publish an event: last event, event sequence, its counter and the lockout state.
+ */
+void Supervisor_RecordEvent(Supervisor_EventType Event)
+{
+	/* One update for the whole record, a supervisor read never sees half of it */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		switch (Event)
+		{
+		case SUPERVISOR_EVENT_DOOR_OPENED:
+			Supervisor_IncrementCounter(SUPERVISOR_REG_DOOR_OPENINGS);
+			break;
+
+		case SUPERVISOR_EVENT_WRONG_PASSWORD:
+			Supervisor_IncrementCounter(SUPERVISOR_REG_WRONG_PASSWORDS);
+			break;
+
+		case SUPERVISOR_EVENT_STORAGE_FAILURE:
+			Supervisor_IncrementCounter(SUPERVISOR_REG_STORAGE_FAILURES);
+			break;
+
+		default:
+			break;
+		}
+
+		g_Registers[SUPERVISOR_REG_LAST_EVENT] = Event;
+		g_Registers[SUPERVISOR_REG_EVENT_SEQUENCE]++;
+		Supervisor_RefreshLockout();
+	}
+}
+
+/*
+ * Description:
+ * Publish the wrong attempts left and the lockout periods left.
+ */
+void Supervisor_RefreshLockout(void)
+{
+	g_Registers[SUPERVISOR_REG_ATTEMPTS_LEFT] = Lockout_GetAttemptsLeft();
+	g_Registers[SUPERVISOR_REG_LOCKOUT_PERIODS] = Lockout_GetRemainingPeriods();
+}
+
+/*
+ * Description:
+ * Return the door motor speed configured by the supervisor.
+ */
+uint8 Supervisor_GetMotorSpeed(void)
+{
+	return g_Registers[SUPERVISOR_REG_MOTOR_SPEED];
+}
+
+/*
+ * Description:
+ * Return TRUE if the supervisor lets the buzzer sound during the lockout.
+ */
+boolean Supervisor_IsAlarmEnabled(void)
+{
+	return g_Registers[SUPERVISOR_REG_ALARM_ENABLE];
+}
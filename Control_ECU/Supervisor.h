@@ -0,0 +1,154 @@
+/*****************************************************************************************************************
+ * File Name: Supervisor.h
+ * Date: 18/10/2026
+ * Driver: I2C Register Map for the Building Supervisor Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "Scheduler.h"
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * A supervisor on the I2C bus polls the lock at its TWI address (TWI_ConfigType.I2C_Address):
+ * write [register] to set the register pointer, then read from there, or write [register][data...].
+ * The 16-bit registers are little endian. The counters count since the last reset.
+ */
+#define SUPERVISOR_REG_ID                    0x00
+#define SUPERVISOR_REG_VERSION               0x01
+#define SUPERVISOR_REG_DOOR_STATE            0x02
+#define SUPERVISOR_REG_ATTEMPTS_LEFT         0x03
+#define SUPERVISOR_REG_LOCKOUT_PERIODS       0x04
+#define SUPERVISOR_REG_LAST_EVENT            0x05
+#define SUPERVISOR_REG_EVENT_SEQUENCE        0x06 /* incremented with every event, 0x07 is reserved */
+#define SUPERVISOR_REG_DOOR_OPENINGS         0x08
+#define SUPERVISOR_REG_WRONG_PASSWORDS       0x0A
+#define SUPERVISOR_REG_STORAGE_FAILURES      0x0C
+#define SUPERVISOR_REG_HASH_CYCLES           0x0E /* measured cycles of one PIN hash iteration / 16 */
+#define SUPERVISOR_REG_BOOT_TIME             0x10 /* storage boot time in msec */
+
+/* Estimated average current of the controller alone in uA (Power_GetCurrent) */
+#define SUPERVISOR_REG_IDLE_CURRENT          0x12 /* waiting for the main option */
+#define SUPERVISOR_REG_DOOR_CURRENT          0x14 /* door moving */
+#define SUPERVISOR_REG_LOCKOUT_CURRENT       0x16 /* lockout running */
+
+/* Scheduler latency monitor (Scheduler_GetStatistics), the times in msec */
+#define SUPERVISOR_REG_MAX_RUN               0x18 /* longest run of the application for one event */
+#define SUPERVISOR_REG_MAX_LATENCY           0x1A /* longest wait of an event */
+#define SUPERVISOR_REG_LATE_EVENTS           0x1C
+#define SUPERVISOR_REG_OVERRUNS              0x1E
+#define SUPERVISOR_REG_OVERRUN_STATE         0x20 /* application step of the longest overrun */
+#define SUPERVISOR_REG_OVERRUN_EVENT         0x21
+#define SUPERVISOR_REG_OVERRUN_TIME          0x22
+
+/* Watchdog record (Watchdog_GetRecord), kept across the resets */
+#define SUPERVISOR_REG_WATCHDOG_RESETS       0x24
+#define SUPERVISOR_REG_WATCHDOG_STAGE        0x26 /* step stuck at the last watchdog reset, 0x27 is reserved */
+
+/* Configuration registers, the only ones the supervisor can write */
+#define SUPERVISOR_REG_CONFIG_START          0x28
+#define SUPERVISOR_REG_MOTOR_SPEED           0x28 /* door motor speed in percent (1 - 100) */
+#define SUPERVISOR_REG_ALARM_ENABLE          0x29 /* buzzer during the lockout (FALSE / TRUE) */
+
+#define SUPERVISOR_REGISTERS_NUMBER          0x2A
+
+/* Answer of SUPERVISOR_REG_ID, and version of this register map */
+#define SUPERVISOR_DEVICE_ID                 0xD1
+#define SUPERVISOR_MAP_VERSION               8
+
+/* Unit of SUPERVISOR_REG_HASH_CYCLES in cycles: 16 bits of it hold up to 1 M cycles, beyond any calibration */
+#define SUPERVISOR_HASH_CYCLES_UNIT          16UL
+
+/* Configuration at reset */
+#define SUPERVISOR_DEFAULT_MOTOR_SPEED       100
+#define SUPERVISOR_DEFAULT_ALARM_ENABLE      TRUE
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef enum
+{
+	SUPERVISOR_DOOR_CLOSED, SUPERVISOR_DOOR_OPENING, SUPERVISOR_DOOR_OPEN, SUPERVISOR_DOOR_CLOSING,
+	SUPERVISOR_DOOR_LOCKED_OUT, SUPERVISOR_DOOR_STOPPED
+}Supervisor_DoorStateType;
+
+typedef enum
+{
+	SUPERVISOR_EVENT_NONE, SUPERVISOR_EVENT_DOOR_OPENED, SUPERVISOR_EVENT_WRONG_PASSWORD,
+	SUPERVISOR_EVENT_PASSWORD_CHANGED, SUPERVISOR_EVENT_LOCKOUT_STARTED, SUPERVISOR_EVENT_LOCKOUT_ENDED,
+	SUPERVISOR_EVENT_STORAGE_FAILURE, SUPERVISOR_EVENT_STORAGE_REPAIRED, SUPERVISOR_EVENT_EMERGENCY_STOP,
+	SUPERVISOR_EVENT_WATCHDOG_RESET
+}Supervisor_EventType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Fill the register map with the lockout state and the default configuration, then serve it in TWI slave
+ * mode. Must be called after TWI_Init, Lockout_Init and the PIN hash calibration with the I-bit set.
+ */
+void Supervisor_Init(void);
+
+/*
+ * Description:
+ * Publish the time taken to bring the storage up at boot (saturated at 0xFFFF msec).
+ */
+void Supervisor_SetBootTime(uint16 Milliseconds);
+
+/*
+ * Description:
+ * Publish the estimated current of the controller in uA while idle, while the door moves and during the lockout.
+ */
+void Supervisor_SetCurrents(uint16 Idle, uint16 Door, uint16 Lockout);
+
+/*
+ * Description:
+ * Publish the scheduler latency monitor statistics.
+ */
+void Supervisor_SetLatencies(const Scheduler_StatisticsType *Statistics);
+
+/*
+ * Description:
+ * Publish the watchdog resets and the step stuck at the last one.
+ */
+void Supervisor_SetWatchdog(uint16 Resets, uint8 Stage);
+
+/*
+ * Description:
+ * Publish the door state.
+ */
+void Supervisor_SetDoorState(Supervisor_DoorStateType State);
+
+/*
+ * Description:
+ * Publish an event: last event, event sequence, its counter and the lockout state.
+ */
+void Supervisor_RecordEvent(Supervisor_EventType Event);
+
+/*
+ * Description:
+ * Publish the wrong attempts left and the lockout periods left.
+ */
+void Supervisor_RefreshLockout(void);
+
+/*
+ * Description:
+ * Return the door motor speed configured by the supervisor.
+ */
+uint8 Supervisor_GetMotorSpeed(void);
+
+/*
+ * Description:
+ * Return TRUE if the supervisor lets the buzzer sound during the lockout.
+ */
+boolean Supervisor_IsAlarmEnabled(void);
+
+#endif /* SUPERVISOR_H_ */
@@ -5,6 +5,8 @@
  * Author: Youssef Zaki
  ******************************************************************************************************************/
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
 #include "Common_Macros.h"
 #include "GPIO.h"
 #include "TIMER0.h"
@@ -16,6 +18,70 @@
 /* Global variables to hold the address of the call back function in the application */
 static volatile void (*g_CallBackPtr)(void) = NULL_PTR;
 
+/* Overflows of TCNT0 since the first initialization, the upper bits of the timestamp */
+static volatile uint32 g_Overflows = 0;
+
+/* CPU cycles of one count of TCNT0 as a power of two (log2 of the pre-scalar) */
+static uint8 g_PrescalerShift = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+/* Interrupt for Normal (Overflow) and PWM Modes, extends TCNT0 for the timestamp */
+ISR(TIMER0_OVF_vect)
+{
+	g_Overflows++;
+
+	if(g_CallBackPtr != NULL_PTR)
+	{
+		/* Call the Call Back function in the application after the overflow */
+		(*g_CallBackPtr)();
+	}
+}
+/* Interrupt for Compare Mode */
+ISR(TIMER0_COMP_vect)
+{
+	if(g_CallBackPtr != NULL_PTR)
+	{
+		/* Call the Call Back function in the application after the compare match */
+		(*g_CallBackPtr)();
+	}
+}
+
+/****************************************************************************************
+ *                                      Private Functions                               *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Keep the CPU cycles of one count of the selected pre-scalar (an external clock counts edges, shift 0).
+ */
+static void Timer0_SetPrescalerShift(Timer0_Clock_Select Prescalar)
+{
+	switch (Prescalar)
+	{
+	case TIMER0_Prescaler_8:
+		g_PrescalerShift = 3;
+		break;
+
+	case TIMER0_Prescaler_64:
+		g_PrescalerShift = 6;
+		break;
+
+	case TIMER0_Prescaler_256:
+		g_PrescalerShift = 8;
+		break;
+
+	case TIMER0_Prescaler_1024:
+		g_PrescalerShift = 10;
+		break;
+
+	default:
+		g_PrescalerShift = 0;
+		break;
+	}
+}
+
 /****************************************************************************************
  *                                      Functions Definitions                           *
  ****************************************************************************************/
@@ -35,6 +101,7 @@ void Timer0_NonPWM_Mode_Init(const Timer0_ConfigType* Config_Ptr)
 	TCNT0 = Config_Ptr -> Initial_Value;
 	SET_BIT(TCCR0, FOC0);
 	TCCR0 = (TCCR0 & 0xF8) | (Config_Ptr -> Prescalar);
+	Timer0_SetPrescalerShift(Config_Ptr -> Prescalar);
 
 	if (Config_Ptr -> Timer_Mode == TIMER0_Normal_0)
 	{
@@ -76,6 +143,7 @@ void Timer0_PWM_Mode_Init(const Timer0_ConfigType* Config_Ptr)
 	CLEAR_BIT(TCCR0, FOC0);
 
 	TCCR0 = (TCCR0 & 0xF8) | (Config_Ptr -> Prescalar);
+	Timer0_SetPrescalerShift(Config_Ptr -> Prescalar);
 
 	GPIO_SetupPinDirection(PORTB_ID, PIN3_ID, OUTPUT_PIN);
 
@@ -114,7 +182,46 @@ void Timer0_DeInit(void)
 {
 	TCNT0 = 0;
 	TCCR0 = 0;
-	TIMSK = 0;
+	TIMSK &= 0xFC;       /* TIMSK & 1111 1100, clear OCIE0 and TOIE0 only */
+}
+
+/*
+ * Description:
+ * Return the CPU cycles counted by Timer0 (overflows, TCNT0 and pre-scalar) with the resolution of one count.
+ * Valid in Normal Mode, and in Fast PWM Mode after Timer0_StartTimestamp. Subtract two readings taken while
+ * Timer0 runs to get a duration.
+ */
+uint32 Timer0_GetTimestamp(void)
+{
+	uint32 Overflows;
+	uint8 Count;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Overflows = g_Overflows;
+		Count = TCNT0;
+
+		/* TCNT0 overflowed and its interrupt is still waiting, read it again after the overflow */
+		if (BIT_IS_SET(TIFR, TOV0))
+		{
+			Count = TCNT0;
+			Overflows++;
+		}
+	}
+
+	return ((Overflows << 8) | Count) << g_PrescalerShift;
+}
+
+/*
+ * Description:
+ * Count the overflows of Timer0 in PWM Modes for Timer0_GetTimestamp (its interrupt every 256 counts), until
+ * Timer0_DeInit. Must be called after Timer0_PWM_Mode_Init.
+ */
+void Timer0_StartTimestamp(void)
+{
+	/* An overflow of the PWM before now isn't counted */
+	TIFR = (1<<TOV0);
+	SET_BIT(TIMSK, TOIE0);
 }
 
 /*
@@ -5,10 +5,64 @@
  * Author: Youssef Zaki
  ******************************************************************************************************************/
 #include "Standard_Types.h"
+#include "Common_Macros.h"
 
 #ifndef TIMER0_H_
 #define TIMER0_H_
 
+/****************************************************************************************
+ *                                      Macros Definitions                              *
+ ****************************************************************************************/
+
+/*
+ * Timer0_GetTimestamp counts CPU cycles, it wraps after 2^32 cycles (537 seconds at 8 Mhz).
+ * With F_CPU/8 one count is 1 usec at 8 Mhz and the overflow interrupt comes every 256 usec, so the PWM modes
+ * count the overflows only after Timer0_StartTimestamp (the profiling build), the interrupt would wake the
+ * sleeping CPU four times every tick.
+ */
+#define TIMER0_CYCLES_TO_US(CYCLES)          ((CYCLES) / (F_CPU / 1000000UL))
+
+/*
+ * Configuration from a duration, computed at compile time from F_CPU: a CTC period of PERIOD_US usec takes
+ * the smallest pre-scaler (the finest resolution) whose counts fit in the 8-bit compare register, the counts
+ * are rounded to the nearest one. A period shorter than one count or longer than 256 counts at F_CPU/1024
+ * stops the build, like a DIVIDER that isn't one of the pre-scalers.
+ *     Timer0_ConfigType Config = TIMER0_CTC_CONFIG_MS(10);
+ */
+#define TIMER0_COUNTS(PERIOD_US,DIVIDER)    ((((F_CPU / 1000ULL) * (PERIOD_US) / (DIVIDER)) + 500ULL) / 1000ULL)
+
+#define TIMER0_FITS(PERIOD_US,DIVIDER)      ((TIMER0_COUNTS(PERIOD_US,DIVIDER) >= 1ULL) && \
+                                             (TIMER0_COUNTS(PERIOD_US,DIVIDER) <= 256ULL))
+
+#define TIMER0_IS_DIVIDER(DIVIDER) \
+	(((DIVIDER) == 1) || ((DIVIDER) == 8) || ((DIVIDER) == 64) || ((DIVIDER) == 256) || \
+	((DIVIDER) == 1024))
+
+/* Smallest pre-scaler division reaching the period */
+#define TIMER0_DIVIDER(PERIOD_US) \
+	((TIMER0_COUNTS(PERIOD_US,1ULL) <= 256ULL) ? 1ULL : \
+	(TIMER0_COUNTS(PERIOD_US,8ULL) <= 256ULL) ? 8ULL : \
+	(TIMER0_COUNTS(PERIOD_US,64ULL) <= 256ULL) ? 64ULL : \
+	(TIMER0_COUNTS(PERIOD_US,256ULL) <= 256ULL) ? 256ULL : \
+	1024ULL)
+
+/* Clock select of a pre-scaler division */
+#define TIMER0_PRESCALER(DIVIDER) \
+	((((DIVIDER) == 1) ? TIMER0_Prescaler_1 : ((DIVIDER) == 8) ? TIMER0_Prescaler_8 : \
+	((DIVIDER) == 64) ? TIMER0_Prescaler_64 : ((DIVIDER) == 256) ? TIMER0_Prescaler_256 : \
+	((DIVIDER) == 1024) ? TIMER0_Prescaler_1024 : \
+	TIMER0_No_Clock) + \
+	STATIC_CHECK(TIMER0_IS_DIVIDER(DIVIDER)))
+
+/* Compare value (TOP) of a period at a pre-scaler division */
+#define TIMER0_COMPARE(PERIOD_US,DIVIDER) \
+	((uint8)(TIMER0_COUNTS(PERIOD_US,DIVIDER) - 1ULL) + STATIC_CHECK(TIMER0_FITS(PERIOD_US,DIVIDER)))
+
+#define TIMER0_CTC_CONFIG_US(PERIOD_US) \
+	{0, TIMER0_COMPARE(PERIOD_US,TIMER0_DIVIDER(PERIOD_US)), TIMER0_PRESCALER(TIMER0_DIVIDER(PERIOD_US)), TIMER0_CTC_2}
+
+#define TIMER0_CTC_CONFIG_MS(PERIOD_MS)     TIMER0_CTC_CONFIG_US((PERIOD_MS) * 1000ULL)
+
 /****************************************************************************************
  *                                      Types Declaration                               *
  ****************************************************************************************/
@@ -81,6 +135,21 @@ void TIMER0_PWM_Start(uint8 Duty_Cycle);
  */
 void Timer0_DeInit(void);
 
+/*
+ * Description:
+ * Return the CPU cycles counted by Timer0 (overflows, TCNT0 and pre-scalar) with the resolution of one count.
+ * Valid in Normal Mode, and in Fast PWM Mode after Timer0_StartTimestamp. Subtract two readings taken while
+ * Timer0 runs to get a duration.
+ */
+uint32 Timer0_GetTimestamp(void);
+
+/*
+ * Description:
+ * Count the overflows of Timer0 in PWM Modes for Timer0_GetTimestamp (its interrupt every 256 counts), until
+ * Timer0_DeInit. Must be called after Timer0_PWM_Mode_Init.
+ */
+void Timer0_StartTimestamp(void);
+
 /*
  * Description:
  * Function to set the Call Back function address.
@@ -5,10 +5,79 @@
  * Author: Youssef Zaki
  ******************************************************************************************************************/
 #include "Standard_Types.h"
+#include "Common_Macros.h"
 
 #ifndef TIMER1_H_
 #define TIMER1_H_
 
+/****************************************************************************************
+ *                                      Macros Definitions                              *
+ ****************************************************************************************/
+
+/*
+ * Configuration from a duration, computed at compile time from F_CPU: a CTC period of PERIOD_US usec takes
+ * the smallest pre-scaler (the finest resolution) whose counts fit in the 16-bit compare register, the counts
+ * are rounded to the nearest one. A period shorter than one count or longer than 65536 counts at F_CPU/1024
+ * stops the build, like a DIVIDER that isn't one of the pre-scalers.
+ *     Timer1_ConfigType Config = TIMER1_CTC_CONFIG_MS(10);
+ */
+#define TIMER1_COUNTS(PERIOD_US,DIVIDER)    ((((F_CPU / 1000ULL) * (PERIOD_US) / (DIVIDER)) + 500ULL) / 1000ULL)
+
+#define TIMER1_FITS(PERIOD_US,DIVIDER)      ((TIMER1_COUNTS(PERIOD_US,DIVIDER) >= 1ULL) && \
+                                             (TIMER1_COUNTS(PERIOD_US,DIVIDER) <= 65536ULL))
+
+#define TIMER1_IS_DIVIDER(DIVIDER) \
+	(((DIVIDER) == 1) || ((DIVIDER) == 8) || ((DIVIDER) == 64) || ((DIVIDER) == 256) || \
+	((DIVIDER) == 1024))
+
+/* Smallest pre-scaler division reaching the period */
+#define TIMER1_DIVIDER(PERIOD_US) \
+	((TIMER1_COUNTS(PERIOD_US,1ULL) <= 65536ULL) ? 1ULL : \
+	(TIMER1_COUNTS(PERIOD_US,8ULL) <= 65536ULL) ? 8ULL : \
+	(TIMER1_COUNTS(PERIOD_US,64ULL) <= 65536ULL) ? 64ULL : \
+	(TIMER1_COUNTS(PERIOD_US,256ULL) <= 65536ULL) ? 256ULL : \
+	1024ULL)
+
+/* Clock select of a pre-scaler division */
+#define TIMER1_PRESCALER(DIVIDER) \
+	((((DIVIDER) == 1) ? TIMER1_Prescaler_1 : ((DIVIDER) == 8) ? TIMER1_Prescaler_8 : \
+	((DIVIDER) == 64) ? TIMER1_Prescaler_64 : ((DIVIDER) == 256) ? TIMER1_Prescaler_256 : \
+	((DIVIDER) == 1024) ? TIMER1_Prescaler_1024 : \
+	TIMER1_No_Clock) + \
+	STATIC_CHECK(TIMER1_IS_DIVIDER(DIVIDER)))
+
+/* Compare value (TOP) of a period at a pre-scaler division */
+#define TIMER1_COMPARE(PERIOD_US,DIVIDER) \
+	((uint16)(TIMER1_COUNTS(PERIOD_US,DIVIDER) - 1ULL) + STATIC_CHECK(TIMER1_FITS(PERIOD_US,DIVIDER)))
+
+#define TIMER1_CTC_CONFIG_US(PERIOD_US) \
+	{0, TIMER1_COMPARE(PERIOD_US,TIMER1_DIVIDER(PERIOD_US)), TIMER1_PRESCALER(TIMER1_DIVIDER(PERIOD_US)), TIMER1_CTC_4}
+
+#define TIMER1_CTC_CONFIG_MS(PERIOD_MS)     TIMER1_CTC_CONFIG_US((PERIOD_MS) * 1000ULL)
+
+/*
+ * Frequency PWM (Timer1_PWM_SetFrequency): Fast PWM Mode with ICR1 as TOP, OC1A on PD5 and OC1B on PD4, both
+ * non-inverting. A period is F_CPU / (pre-scaler * Frequency) counts with the smallest pre-scaler fitting in
+ * 16 bits, the finest duty resolution: one per-mille step needs 1000 counts (up to 8 Khz at 8 Mhz).
+ */
+#define TIMER1_PWM_MIN_COUNTS               2UL
+#define TIMER1_PWM_MAX_FREQUENCY            (F_CPU / TIMER1_PWM_MIN_COUNTS)
+#define TIMER1_PWM_DUTY_FULL                1000    /* per-mille */
+
+/*
+ * Input capture (Timer1_Capture_Init): Timer1 counts freely in Normal Mode, every selected edge on ICP1 (PD6)
+ * copies the count into ICR1 and the interrupt queues it extended to 32 bits with the overflows. The captures
+ * need Timer1 alone, not while the frequency PWM runs (ICR1 is its TOP). With both edges the pulses must last
+ * longer than the capture interrupt (a few usec), the edge is switched from it.
+ */
+#define TIMER1_CAPTURE_BUFFER_SIZE          8    /* power of two */
+
+#if ((TIMER1_CAPTURE_BUFFER_SIZE & (TIMER1_CAPTURE_BUFFER_SIZE - 1)) != 0) || (TIMER1_CAPTURE_BUFFER_SIZE > 128)
+
+#error "The Timer1 capture buffer size should be a power of two up to 128"
+
+#endif
+
 /*******************************************************************************************
  *                                      Types Declaration                                  *
  *******************************************************************************************/
@@ -52,6 +121,31 @@ Timer1_Prescaler prescaler;
 Timer1_Mode mode;
 } Timer1_ConfigType;
 
+typedef enum
+{
+	TIMER1_Channel_A,
+	TIMER1_Channel_B
+}Timer1_Channel;
+
+typedef enum
+{
+	TIMER1_Capture_Falling_Edge,
+	TIMER1_Capture_Rising_Edge,
+	TIMER1_Capture_Both_Edges
+}Timer1_Capture_Edge;
+
+typedef struct {
+Timer1_Prescaler prescaler;
+Timer1_Capture_Edge edge;
+boolean noise_canceler; /* an edge is taken after four equal samples of ICP1 (four cycles later) */
+} Timer1_CaptureConfigType;
+
+typedef struct
+{
+	uint32 Timestamp;          /* Timer1 counts since Timer1_Capture_Init, wraps after 2^32 counts */
+	uint8 Level;               /* LOGIC_HIGH after a rising edge, LOGIC_LOW after a falling edge */
+}Timer1_CaptureType;
+
 /*******************************************************************************
  *                              Functions Prototypes                           *
  *******************************************************************************/
@@ -65,6 +159,7 @@ Timer1_Mode mode;
  * 4. Configure the TCCR1B Register according to the Timer1 Mode.
  * 5. In CTC Mode Let OCR1A = the compare value (TOP Value).
  * 6. Set the OCIE1A in TIMSK Register to enable the interrupt of timer1 mode A.
+ * 7. Clear TOV1, Timer1_HasOverflowed tells the overflows of this count only.
  */
 void Timer1_NonPWm_Mode_Init(const Timer1_ConfigType * Config_Ptr);
 
@@ -82,18 +177,64 @@ void Timer1_PWM_Mode_Init(const Timer1_ConfigType * Config_Ptr);
 
 /*
  * Description:
- * Function to
- * 1. calculate the OCR1A Value from required Duty Cycle.
- * 2. Put Compare and TOP values of (ICR1 or OCR1A) registers.
+ * Run Timer1 as a PWM of the given frequency in Hz (1 - TIMER1_PWM_MAX_FREQUENCY), the duty cycles of both
+ * channels are kept. Started from a stopped timer both outputs stay low until Timer1_PWM_SetDuty. While the PWM
+ * runs the new period starts after the next TOP, no period is cut. Returns FALSE if the frequency is out of reach.
+ */
+boolean Timer1_PWM_SetFrequency(uint32 Frequency);
+
+/*
+ * Description:
+ * Set the duty cycle of a channel in per-mille (0 - TIMER1_PWM_DUTY_FULL), it starts after the next TOP (OCR1x
+ * are double buffered). 0 disconnects the pin at once (low), a compare of 0 would still give a short pulse.
  */
-void TIMER1_PWM_Start (uint16 Duty_Cycle);
+void Timer1_PWM_SetDuty(Timer1_Channel Channel, uint16 Duty_PerMille);
 
 /*
  * Description:
- * Function to disable the Timer1.
+ * Start timestamping the edges on ICP1: Timer1 counts from zero in Normal Mode at the pre-scaler, the captures
+ * queue in a ring of TIMER1_CAPTURE_BUFFER_SIZE filled by the capture interrupt. The I-bit must be set.
+ */
+void Timer1_Capture_Init(const Timer1_CaptureConfigType * Config_Ptr);
+
+/*
+ * Description:
+ * Take the oldest capture out of the ring, returns FALSE if there is none.
+ */
+boolean Timer1_Capture_Read(Timer1_CaptureType * Capture_Ptr);
+
+/*
+ * Description:
+ * Return the number of captures lost because the ring was full (saturated at 0xFF).
+ */
+uint8 Timer1_Capture_GetLostCaptures(void);
+
+/*
+ * Description:
+ * Set the function called from the capture interrupt when a capture enters the empty ring, the application
+ * reads until Timer1_Capture_Read returns FALSE.
+ */
+void Timer1_Capture_SetCallBack(void(*a_ptr)(void));
+
+/*
+ * Description:
+ * Function to disable the Timer1 (the PWM outputs and the captures too).
  */
 void Timer1_DeInit(void);
 
+/*
+ * Description:
+ * Function to read the current count of Timer1 (TCNT1).
+ */
+uint16 Timer1_GetCount(void);
+
+/*
+ * Description:
+ * Function to tell whether the count overflowed since Timer1_NonPWm_Mode_Init in Normal Mode (TOV1, the
+ * overflow interrupt is off in this mode so the flag stays set).
+ */
+boolean Timer1_HasOverflowed(void);
+
 /*
  * Description:
  * Function to set the Call Back function address.
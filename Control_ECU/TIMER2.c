@@ -0,0 +1,122 @@
+/*******************************************************************************************************************
+ * File Name: TIMER2.c
+ * Date: 18/10/2026
+ * Driver: ATmega32 TIMER2 Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "Common_Macros.h"
+#include "TIMER2.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Global variables to hold the address of the call back function in the application */
+static void (*volatile g_CallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Interrupt for Normal (Overflow) Mode */
+ISR(TIMER2_OVF_vect)
+{
+	if (g_CallBackPtr != NULL_PTR)
+	{
+		(*g_CallBackPtr)();
+	}
+}
+
+/* Interrupt for Compare Mode */
+ISR(TIMER2_COMP_vect)
+{
+	if (g_CallBackPtr != NULL_PTR)
+	{
+		(*g_CallBackPtr)();
+	}
+}
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Initialization of Timer2 (Enable Timer2)
+ * 1. Let the TCNT2 Register = The Start value of the timer.
+ * 2. Enable CS22:0 bits according to the required pre-scalar.
+ * 3. Configure the TCCR2 Register according to the Timer2 Mode.
+ * 4. In CTC Mode Let OCR2 = the compare value (TOP Value).
+ * 5. Enable the interrupt of the mode (TOIE2 or OCIE2) without touching the bits of the other timers.
+ */
+void Timer2_NonPWM_Mode_Init(const Timer2_ConfigType* Config_Ptr)
+{
+	/* Synchronous mode, Timer2 counts the I/O clock */
+	ASSR = 0;
+
+	TCNT2 = Config_Ptr -> Initial_Value;
+
+	if (Config_Ptr -> Timer_Mode == TIMER2_CTC_2)
+	{
+		OCR2 = Config_Ptr -> Compare_Value;
+
+		/* Configuration of CTC Mode
+		 * FOC2 = 1, WGM21 = 1, WGM20 = 0, COM21 = 0, COM20 = 0
+		 */
+		TCCR2 = (1 << FOC2) | (1 << WGM21) | (Config_Ptr -> Prescalar);
+
+		CLEAR_BIT(TIMSK, TOIE2);
+		SET_BIT(TIMSK, OCIE2);
+	}
+	else
+	{
+		/* Configuration of Normal Mode
+		 * FOC2 = 1, WGM21 = 0, WGM20 = 0, COM21 = 0, COM20 = 0
+		 */
+		TCCR2 = (1 << FOC2) | (Config_Ptr -> Prescalar);
+
+		CLEAR_BIT(TIMSK, OCIE2);
+		SET_BIT(TIMSK, TOIE2);
+	}
+}
+
+/*
+ * Description:
+ * De-initialization of Timer2 (Disable)
+ */
+void Timer2_DeInit(void)
+{
+	TCCR2 = 0;
+	TCNT2 = 0;
+	CLEAR_BIT(TIMSK, OCIE2);
+	CLEAR_BIT(TIMSK, TOIE2);
+}
+
+/*
+ * Description:
+ * Function to read the current count of Timer2 (TCNT2).
+ */
+uint8 Timer2_GetCount(void)
+{
+	return TCNT2;
+}
+
+/*
+ * Description:
+ * Function to tell if a compare match happened that its interrupt didn't serve yet (OCF2 still set).
+ */
+boolean Timer2_IsComparePending(void)
+{
+	return BIT_IS_SET(TIFR, OCF2) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void Timer2_SetCallBack(void(*a_ptr)(void))
+{
+	g_CallBackPtr = a_ptr;
+}
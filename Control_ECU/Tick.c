@@ -0,0 +1,125 @@
+/*****************************************************************************************************************
+ * File Name: Tick.c
+ * Date: 18/10/2026
+ * Driver: 1 msec System Tick Service Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <util/atomic.h>
+#include "TIMER2.h"
+#include "Tick.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static volatile Tick_Type g_Ticks = 0;
+
+/* Global variables to hold the address of the call back function in the application */
+static void (*volatile g_CallBackPtr)(void) = NULL_PTR;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Called from the Timer2 compare interrupt every millisecond.
+ */
+static void Tick_CallBack(void)
+{
+	g_Ticks++;
+
+	if (g_CallBackPtr != NULL_PTR)
+	{
+		(*g_CallBackPtr)();
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Start counting the milliseconds on Timer2. The I-bit must be set for the tick to advance.
+ */
+void Tick_Init(void)
+{
+	Timer2_ConfigType Timer2_Config =
+		{0, TIMER2_COMPARE(1000UL, TICK_TIMER2_DIVIDER), TIMER2_PRESCALER(TICK_TIMER2_DIVIDER), TIMER2_CTC_2};
+
+	g_Ticks = 0;
+	Timer2_SetCallBack(Tick_CallBack);
+	Timer2_NonPWM_Mode_Init(&Timer2_Config);
+}
+
+/*
+ * Description:
+ * Return the milliseconds since Tick_Init (the four bytes are read with the interrupts disabled).
+ */
+Tick_Type Tick_Now(void)
+{
+	Tick_Type Now;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Now = g_Ticks;
+	}
+
+	return Now;
+}
+
+/*
+ * Description:
+ * Return the Timer2 counts since Tick_Init (TICK_COUNTS_PER_MS per msec) for the measurements finer than one
+ * msec, subtract two readings to get a duration. Wraps after 9.5 hours at 8 Mhz.
+ */
+uint32 Tick_NowCounts(void)
+{
+	Tick_Type Ticks;
+	uint8 Count;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Ticks = g_Ticks;
+		Count = Timer2_GetCount();
+
+		/* The counter restarted from zero on a compare match whose interrupt is still waiting, read it again */
+		if (Timer2_IsComparePending())
+		{
+			Count = Timer2_GetCount();
+			Ticks++;
+		}
+	}
+
+	return (Ticks * TICK_COUNTS_PER_MS) + Count;
+}
+
+/*
+ * Description:
+ * Return the milliseconds since Start, correct across the wrap of the counter.
+ */
+Tick_Type Tick_Elapsed(Tick_Type Start)
+{
+	return (Tick_Type)(Tick_Now() - Start);
+}
+
+/*
+ * Description:
+ * Wait the given milliseconds.
+ */
+void Tick_Wait(Tick_Type Milliseconds)
+{
+	Tick_Type Start = Tick_Now();
+
+	while (Tick_Elapsed(Start) < Milliseconds);
+}
+
+/*
+ * Description:
+ * Set the function called from the tick interrupt after every millisecond (the timer wheel).
+ */
+void Tick_SetCallBack(void(*a_ptr)(void))
+{
+	g_CallBackPtr = a_ptr;
+}
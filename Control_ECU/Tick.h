@@ -0,0 +1,91 @@
+/*****************************************************************************************************************
+ * File Name: Tick.h
+ * Date: 18/10/2026
+ * Driver: 1 msec System Tick Service Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "TIMER2.h"
+
+#ifndef TICK_H_
+#define TICK_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The tick runs on Timer2 in CTC Mode at F_CPU/64, one compare match every millisecond:
+ * OCR2 = F_CPU / 64 / 1000 - 1 (124 at 8 Mhz). Timer0 and Timer1 stay free for the motor and the measurements.
+ * The pre-scaler is fixed rather than the smallest one (TIMER2_DIVIDER), the counts are a power of two of cycles.
+ */
+#define TICK_TIMER2_DIVIDER                  64UL
+#define TICK_TIMER2_COMPARE                  ((F_CPU / TICK_TIMER2_DIVIDER / 1000UL) - 1UL)
+
+#if (!TIMER2_FITS(1000UL, TICK_TIMER2_DIVIDER) || ((F_CPU % (TICK_TIMER2_DIVIDER * 1000UL)) != 0))
+
+#error "The 1 msec tick needs F_CPU to be a multiple of 64 Khz between 128 Khz and 16.384 Mhz"
+
+#endif
+
+/* Timer2 counts in one msec, the resolution of Tick_NowCounts (8 usec at 8 Mhz) */
+#define TICK_COUNTS_PER_MS                   (TICK_TIMER2_COMPARE + 1UL)
+
+/* CPU cycles of one Tick count as a power of two (F_CPU/64) */
+#define TICK_COUNT_CYCLES_SHIFT              6
+
+#if ((1UL << TICK_COUNT_CYCLES_SHIFT) != TICK_TIMER2_DIVIDER)
+
+#error "TICK_COUNT_CYCLES_SHIFT doesn't match the tick pre-scaler"
+
+#endif
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Milliseconds since Tick_Init, wraps after 49.7 days (compare with Tick_Elapsed, never directly) */
+typedef uint32 Tick_Type;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Start counting the milliseconds on Timer2. The I-bit must be set for the tick to advance.
+ */
+void Tick_Init(void);
+
+/*
+ * Description:
+ * Return the milliseconds since Tick_Init (the four bytes are read with the interrupts disabled).
+ */
+Tick_Type Tick_Now(void);
+
+/*
+ * Description:
+ * Return the Timer2 counts since Tick_Init (TICK_COUNTS_PER_MS per msec) for the measurements finer than one
+ * msec, subtract two readings to get a duration. Wraps after 9.5 hours at 8 Mhz.
+ */
+uint32 Tick_NowCounts(void);
+
+/*
+ * Description:
+ * Return the milliseconds since Start, correct across the wrap of the counter.
+ */
+Tick_Type Tick_Elapsed(Tick_Type Start);
+
+/*
+ * Description:
+ * Wait the given milliseconds.
+ */
+void Tick_Wait(Tick_Type Milliseconds);
+
+/*
+ * Description:
+ * Set the function called from the tick interrupt after every millisecond (the timer wheel).
+ */
+void Tick_SetCallBack(void(*a_ptr)(void));
+
+#endif /* TICK_H_ */
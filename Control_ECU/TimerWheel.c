@@ -0,0 +1,247 @@
+/*****************************************************************************************************************
+ * File Name: TimerWheel.c
+ * Date: 18/10/2026
+ * Driver: Hierarchical Software Timer Wheel Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <util/atomic.h>
+#include "Tick.h"
+#include "TimerWheel.h"
+
+#define TIMERWHEEL_SLOT_MASK                 (TIMERWHEEL_SLOTS - 1)
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static TimerWheel_TimerType *g_Wheel[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+
+/* Last tick handled by the wheel */
+static volatile Tick_Type g_Now = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Link a timer at the head of the slot of its expiry time. The caller disables the interrupts.
+ */
+static void TimerWheel_Link(TimerWheel_TimerType *Timer)
+{
+	Tick_Type Delta = (Tick_Type)(Timer -> Expiry - g_Now);
+	Tick_Type Expiry = Timer -> Expiry;
+	TimerWheel_TimerType **Slot;
+	uint8 Level;
+
+	/* Too far for the last level, park it there and link it again when its slot is spread */
+	if (Delta > TIMERWHEEL_MAX_DELTA)
+	{
+		Delta = TIMERWHEEL_MAX_DELTA;
+		Expiry = g_Now + TIMERWHEEL_MAX_DELTA;
+	}
+
+	for (Level = 0; Level < (TIMERWHEEL_LEVELS - 1); Level++)
+	{
+		if (Delta < (1UL << (TIMERWHEEL_SLOT_BITS * (Level + 1))))
+		{
+			break;
+		}
+	}
+
+	Slot = &g_Wheel[Level][(Expiry >> (TIMERWHEEL_SLOT_BITS * Level)) & TIMERWHEEL_SLOT_MASK];
+
+	Timer -> Slot = Slot;
+	Timer -> Prev = NULL_PTR;
+	Timer -> Next = *Slot;
+	if (*Slot != NULL_PTR)
+	{
+		(*Slot) -> Prev = Timer;
+	}
+	*Slot = Timer;
+}
+
+/*
+ * Description:
+ * Unlink a timer from its slot. The caller disables the interrupts.
+ */
+static void TimerWheel_Unlink(TimerWheel_TimerType *Timer)
+{
+	if (Timer -> Prev != NULL_PTR)
+	{
+		Timer -> Prev -> Next = Timer -> Next;
+	}
+	else
+	{
+		*(Timer -> Slot) = Timer -> Next;
+	}
+
+	if (Timer -> Next != NULL_PTR)
+	{
+		Timer -> Next -> Prev = Timer -> Prev;
+	}
+
+	Timer -> Slot = NULL_PTR;
+}
+
+/*
+ * Description:
+ * Spread the timers of the slot of a level reached by the current tick into the levels below.
+ */
+static void TimerWheel_Cascade(uint8 Level)
+{
+	uint8 Index = (uint8)((g_Now >> (TIMERWHEEL_SLOT_BITS * Level)) & TIMERWHEEL_SLOT_MASK);
+	TimerWheel_TimerType *Timer = g_Wheel[Level][Index];
+	TimerWheel_TimerType *Next;
+
+	g_Wheel[Level][Index] = NULL_PTR;
+
+	while (Timer != NULL_PTR)
+	{
+		Next = Timer -> Next;
+		TimerWheel_Link(Timer);
+		Timer = Next;
+	}
+}
+
+/*
+ * Description:
+ * Called from the tick interrupt every msec: spread the upper slots reached by this tick, then run the timers
+ * of the current level 0 slot. A call back may start or stop any timer, so the slot is popped one by one.
+ */
+static void TimerWheel_Tick(void)
+{
+	TimerWheel_TimerType **Slot;
+	TimerWheel_TimerType *Timer;
+	uint8 Level;
+
+	g_Now++;
+
+	for (Level = 1; (Level < TIMERWHEEL_LEVELS) &&
+		(((g_Now >> (TIMERWHEEL_SLOT_BITS * (Level - 1))) & TIMERWHEEL_SLOT_MASK) == 0); Level++)
+	{
+		TimerWheel_Cascade(Level);
+	}
+
+	Slot = &g_Wheel[0][g_Now & TIMERWHEEL_SLOT_MASK];
+
+	while (*Slot != NULL_PTR)
+	{
+		Timer = *Slot;
+		TimerWheel_Unlink(Timer);
+
+		if (Timer -> Period != 0)
+		{
+			Timer -> Expiry += Timer -> Period;
+			TimerWheel_Link(Timer);
+		}
+
+		if (Timer -> CallBack != NULL_PTR)
+		{
+			Timer -> CallBack();
+		}
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Empty the wheel and drive it from the tick interrupt. Must be called after Tick_Init.
+ */
+void TimerWheel_Init(void)
+{
+	uint8 Level;
+	uint8 Index;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		for (Level = 0; Level < TIMERWHEEL_LEVELS; Level++)
+		{
+			for (Index = 0; Index < TIMERWHEEL_SLOTS; Index++)
+			{
+				g_Wheel[Level][Index] = NULL_PTR;
+			}
+		}
+
+		g_Now = Tick_Now();
+		Tick_SetCallBack(TimerWheel_Tick);
+	}
+}
+
+/*
+ * Description:
+ * Start (or restart) a timer expiring in Delay msec (at least 1), then every Period msec if Period is not 0.
+ */
+void TimerWheel_Start(TimerWheel_TimerType *Timer, Tick_Type Delay, Tick_Type Period, void (*CallBack)(void))
+{
+	if (Delay == 0)
+	{
+		Delay = 1;
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (Timer -> Slot != NULL_PTR)
+		{
+			TimerWheel_Unlink(Timer);
+		}
+
+		Timer -> Expiry = g_Now + Delay;
+		Timer -> Period = Period;
+		Timer -> CallBack = CallBack;
+		TimerWheel_Link(Timer);
+	}
+}
+
+/*
+ * Description:
+ * Stop a timer, nothing happens if it isn't running.
+ */
+void TimerWheel_Stop(TimerWheel_TimerType *Timer)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (Timer -> Slot != NULL_PTR)
+		{
+			TimerWheel_Unlink(Timer);
+		}
+	}
+}
+
+/*
+ * Description:
+ * Return TRUE until a one-shot timer expires or a timer is stopped.
+ */
+boolean TimerWheel_IsRunning(const TimerWheel_TimerType *Timer)
+{
+	boolean Running;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Running = (Timer -> Slot != NULL_PTR);
+	}
+
+	return Running;
+}
+
+/*
+ * Description:
+ * Return the msec left before the next expiry of a timer, 0 if it isn't running.
+ */
+Tick_Type TimerWheel_GetRemaining(const TimerWheel_TimerType *Timer)
+{
+	Tick_Type Remaining = 0;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (Timer -> Slot != NULL_PTR)
+		{
+			Remaining = (Tick_Type)(Timer -> Expiry - g_Now);
+		}
+	}
+
+	return Remaining;
+}
@@ -0,0 +1,85 @@
+/*****************************************************************************************************************
+ * File Name: TimerWheel.h
+ * Date: 18/10/2026
+ * Driver: Hierarchical Software Timer Wheel Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "Tick.h"
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Every software timer runs on the 1 msec tick. The wheel has TIMERWHEEL_LEVELS levels of TIMERWHEEL_SLOTS
+ * slots, a level slot spans all the slots of the level below it:
+ * Level 0: 1 msec slots (up to 16 msec) - Level 1: 16 msec slots (up to 256 msec)
+ * Level 2: 256 msec slots (up to 4.1 seconds) - Level 3: 4.1 seconds slots (up to 65.5 seconds)
+ * A timer is linked into one slot by its expiry time (O(1) start and stop), a tick only runs the timers of
+ * the current level 0 slot. Every 16 msec the next slot of the level above is spread into the level below.
+ * Longer delays are parked in the last level and moved again until they fit.
+ */
+#define TIMERWHEEL_SLOT_BITS                 4
+#define TIMERWHEEL_SLOTS                     (1 << TIMERWHEEL_SLOT_BITS)
+#define TIMERWHEEL_LEVELS                    4
+
+/* The longest delay of the last level */
+#define TIMERWHEEL_MAX_DELTA                 ((1UL << (TIMERWHEEL_SLOT_BITS * TIMERWHEEL_LEVELS)) - 1UL)
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/*
+ * A software timer is owned by its user (static storage), the wheel only links it. The call back runs in the
+ * tick interrupt: it must be short (set a flag, drive a pin) and may start or stop any timer.
+ */
+typedef struct TimerWheel_Timer
+{
+	struct TimerWheel_Timer *Next;
+	struct TimerWheel_Timer *Prev;
+	struct TimerWheel_Timer **Slot;   /* head of the slot holding the timer, NULL_PTR when stopped */
+	Tick_Type Expiry;
+	Tick_Type Period;                 /* 0 for a one-shot timer */
+	void (*CallBack)(void);           /* may be NULL_PTR, the user then polls TimerWheel_IsRunning */
+}TimerWheel_TimerType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Empty the wheel and drive it from the tick interrupt. Must be called after Tick_Init.
+ */
+void TimerWheel_Init(void);
+
+/*
+ * Description:
+ * Start (or restart) a timer expiring in Delay msec (at least 1), then every Period msec if Period is not 0.
+ */
+void TimerWheel_Start(TimerWheel_TimerType *Timer, Tick_Type Delay, Tick_Type Period, void (*CallBack)(void));
+
+/*
+ * Description:
+ * Stop a timer, nothing happens if it isn't running.
+ */
+void TimerWheel_Stop(TimerWheel_TimerType *Timer);
+
+/*
+ * Description:
+ * Return TRUE until a one-shot timer expires or a timer is stopped.
+ */
+boolean TimerWheel_IsRunning(const TimerWheel_TimerType *Timer);
+
+/*
+ * Description:
+ * Return the msec left before the next expiry of a timer, 0 if it isn't running.
+ */
+Tick_Type TimerWheel_GetRemaining(const TimerWheel_TimerType *Timer);
+
+#endif /* TIMERWHEEL_H_ */
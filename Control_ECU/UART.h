@@ -9,6 +9,19 @@
 #ifndef UART_H_
 #define UART_H_
 
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* The receive interrupt keeps the received bytes here until they are read (power of two) */
+#define UART_RX_BUFFER_SIZE                  16
+
+#if ((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) != 0) || (UART_RX_BUFFER_SIZE > 128)
+
+#error "The UART receive buffer size should be a power of two up to 128"
+
+#endif
+
 /*******************************************************************************************
  *                                      Types Declaration                                  *
  *******************************************************************************************/
@@ -75,13 +88,46 @@ void UART_SendByte(uint8 Byte);
 /*
  * Description:
  * Function to receive byte from the another device.
- * 1. RXC bit is set automatically when the received buffer Rx hasn't any unread data.
- * 2. We wait until the all data is read.
- * 3. Then, we can read the received data from the Rx buffer through UDR Register.
- * 4. After read the data, the RXC flag will be cleared.
+ * 1. The receive interrupt (RXCIE) moves every received byte from UDR into the receive buffer.
+ * 2. We sleep (Idle mode) until the buffer holds a byte, the I-bit must be set.
+ * 3. Then, we take the oldest byte out of the buffer.
  */
 uint8 UART_ReceiveByte(void);
 
+/*
+ * Description:
+ * Function to receive byte from the another device within the given milliseconds, like UART_ReceiveByte.
+ * The tick interrupt wakes the sleep every msec to check the time, the Tick service must run.
+ * Returns FALSE if no byte was received in time.
+ */
+boolean UART_ReceiveByteTimeout(uint8 *Byte, uint16 Timeout_Ms);
+
+/*
+ * Description:
+ * Return TRUE if a received byte is waiting in the receive buffer, without waiting for it.
+ */
+boolean UART_IsByteReceived(void);
+
+/*
+ * Description:
+ * Function to set the Call Back function address, called from the receive interrupt when a byte arrives into
+ * an empty receive buffer. The application reads every waiting byte after it.
+ */
+void UART_SetCallBack(void(*a_ptr)(void));
+
+/*
+ * Description:
+ * Return the number of received bytes lost because the receive buffer was full (saturated at 0xFF).
+ */
+uint8 UART_GetLostBytes(void);
+
+/*
+ * Description:
+ * Drop the received frames from Start_Byte to End_Byte included in the receive interrupt (the text sent on
+ * the line for another receiver), none of their bytes is buffered. Equal bytes keep every byte.
+ */
+void UART_SetIgnoredFrame(uint8 Start_Byte, uint8 End_Byte);
+
 /*
  * Description:
  * Function to send string to the another device.
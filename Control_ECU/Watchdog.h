@@ -0,0 +1,75 @@
+/*****************************************************************************************************************
+ * File Name: Watchdog.h
+ * Date: 18/10/2026
+ * Driver: Watchdog Supervision with Stage Checkpoints Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Every long-running stage checks in with Watchdog_Checkpoint (the scheduler at every iteration, the boot
+ * before every step), a stage stuck longer than the watchdog period resets the controller. The ATmega32
+ * watchdog has no interrupt before the reset, so the stage of the last checkpoint is kept in a RAM variable
+ * the start-up code doesn't clear, and Watchdog_Init saves it in the internal EEPROM after the reset.
+ */
+#ifndef WATCHDOG_PERIOD
+#define WATCHDOG_PERIOD                      WDTO_2S    /* 2.1 sec at 5V: the longest recovery from a hang */
+#endif
+
+/*
+ * The record is at the end of the 1 KB internal EEPROM, away from the storage layout:
+ * [0] Stage - [1:2] Watchdog resets (little endian) - [3] Check (complement of the sum of bytes [0:2])
+ */
+#define WATCHDOG_RECORD_ADDRESS              0x3FC
+#define WATCHDOG_RECORD_SIZE                 4
+
+/* Stage of a checkpoint never reached */
+#define WATCHDOG_NO_STAGE                    0xFF
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	uint8 Stage;               /* stage stuck at the last watchdog reset, WATCHDOG_NO_STAGE if none */
+	uint16 Resets;             /* watchdog resets since the record was written first (saturated) */
+}Watchdog_RecordType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Read the reset cause, save the stuck stage in the internal EEPROM record after a watchdog reset, then start
+ * the watchdog (WATCHDOG_PERIOD). Must be called first in main, before any long step.
+ */
+void Watchdog_Init(void);
+
+/*
+ * Description:
+ * Tell the stage starting (or still running) and restart the watchdog period.
+ */
+void Watchdog_Checkpoint(uint8 Stage);
+
+/*
+ * Description:
+ * Return TRUE if this boot follows a watchdog reset.
+ */
+boolean Watchdog_WasReset(void);
+
+/*
+ * Description:
+ * Return the record of the watchdog resets kept in the internal EEPROM.
+ */
+const Watchdog_RecordType* Watchdog_GetRecord(void);
+
+#endif /* WATCHDOG_H_ */
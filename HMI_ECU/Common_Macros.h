@@ -30,4 +30,10 @@
 
 #define GET_BIT(REG,BIT) ( ( REG & (1<<BIT) ) >> BIT )
 
+/* Stop the build if a constant expression (enum values included) is false */
+#define STATIC_ASSERT(CONDITION,NAME) typedef char NAME[(CONDITION) ? 1 : -1]
+
+/* Same check inside an expression (an initializer), it adds zero */
+#define STATIC_CHECK(CONDITION) (0U * sizeof(char[(CONDITION) ? 1 : -1]))
+
 #endif
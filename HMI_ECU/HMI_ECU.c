@@ -2,7 +2,7 @@
  * [File]: HMI_ECU.c
  * [Date]: 21/8/2023
  * [Objective]: Developing a system to unlock a door using a password - HMI ECU.
- * [Drivers]: GPIO - Timer1 - UART - Keypad - LCD
+ * [Drivers]: GPIO - Timer0 (profiling build) - Timer2 - UART - Keypad - LCD
  * [Author]: Youssef Ahmed Zaki
  *************************************************************************************************************************/
 #include <avr/io.h>
@@ -10,19 +10,29 @@
 
 /* MCAL Layer */
 #include "GPIO.h"
-#include "TIMER1.h"
+#include "TIMER0.h"
+#include "TIMER2.h"
 #include "UART.h"
 
 /* HAL Layer */
 #include "Keypad.h"
 #include "LCD.h"
 
+/* Services */
+#include "Tick.h"
+#include "TimerWheel.h"
+#include "Scheduler.h"
+#include "Power.h"
+#include "Profile.h"
+#include "Watchdog.h"
+
 #define HMI_READY               0x10
 #define CONTROL_READY           0x20
 #define PASSWORD_SIZE           5
 
 #define PASSWORDS_UNMATCHED     0x30
 #define PASSWORDS_MATCHED       0x40
+#define STORAGE_FAILURE         0x70
 
 #define PASS_RECEIVED           0x06
 #define DISPLAY_ERROR           0x0C
@@ -30,6 +40,71 @@
 #define OPEN_THE_DOOR           0x03
 #define CHANGE_PASSWORD         0x04
 
+/* Sent by Control ECU after CONTROL_READY at boot to tell whether a password is already saved */
+#define PASSWORD_STORED         0x50
+#define NO_PASSWORD_STORED      0x60
+#define PASSWORD_LOCKED         0x80
+
+/* Accepted by Control ECU in every step, STATUS_QUERY is answered with DOOR_STATUS then the door state */
+#define STATUS_QUERY            0x90
+#define EMERGENCY_STOP          0x91
+#define DOOR_STATUS             0x92
+
+/*
+ * Sent at boot and after a link error, again every HMI_HELLO_MS until answered: Control ECU answers it in every
+ * step with CONTROL_READY then the password state, whatever it was waiting for (a reset of this ECU lost its
+ * side of the exchange)
+ */
+#define HMI_HELLO               0x94
+#define HMI_HELLO_MS            500UL
+
+/*
+ * Longest wait for the next byte of an exchange: Control ECU answers at once but a password check or save
+ * (about 500 msec). An exchange timed out means Control ECU was reset, the link is connected again.
+ */
+#define LINK_TIMEOUT_MS         1000UL
+
+/* Door states reported by Control ECU (same values as its supervisor register) */
+#define DOOR_CLOSED             0x00
+#define DOOR_OPENING            0x01
+#define DOOR_OPEN               0x02
+#define DOOR_CLOSING            0x03
+#define DOOR_LOCKED_OUT         0x04
+#define DOOR_STOPPED            0x05
+
+/* ON/C key: stops the door while it moves */
+#define EMERGENCY_KEY           13
+
+/*
+ * Profiling build: '%' in the main options sends the profiling table as text lines (Profile_Dump) between
+ * PROFILE_FRAME_START and PROFILE_FRAME_END, for a terminal on the line. Both ECUs drop the frames received.
+ */
+#define PROFILE_DUMP_KEY        '%'
+#define PROFILE_FRAME_START     0x95
+#define PROFILE_FRAME_END       0x96
+
+/* The keypad is scanned every 20 msec, a key is taken when two scans in a row see it */
+#define KEYPAD_SCAN_MS          20UL
+
+/* Every message stays 2 seconds on the LCD, the door state is queried every 0.5 second while it moves */
+#define MESSAGE_MS              2000UL
+#define STATUS_POLL_MS          500UL
+
+/* A lockout period lasts 15 seconds */
+#define LOCKOUT_PERIOD_MS       15000UL
+
+/* The seconds left of the lockout are displayed again every second */
+#define DISPLAY_REFRESH_MS      1000UL
+
+/* Scheduler events */
+#define EVENT_KEYPAD_SCAN       0x01
+#define EVENT_UART_RECEIVED     0x02
+#define EVENT_MESSAGE_TIMER     0x03
+#define EVENT_STATUS_TIMER      0x04
+#define EVENT_LOCKOUT_TIMER     0x05
+#define EVENT_DISPLAY_TIMER     0x06
+#define EVENT_HELLO_TIMER       0x07
+
 /* HMI ECU Cases */
 #define ENTER_PASSWORD          0x00
 #define CONFIRM_PASSWORD        0x01
@@ -37,6 +112,12 @@
 #define MAIN_OPTION_SELECTION   0x03
 #define OPENING_DOOR            0x04
 #define PASSWORD_ERROR          0x05
+#define ENTER_OPTION_PASSWORD   0x06
+#define SHOWING_MESSAGE         0x07
+#define WAITING_LINK            0x08
+
+/* Watchdog checkpoint of the boot, the steps above check in with their number (Scheduler_Run) */
+#define BOOT_DRIVERS            0x80
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -45,11 +126,33 @@
  ********************************************************************************************************/
 
 uint8 HMI_ECU_Sequence = 0;
-uint8 Key_Pressed = 0;
-uint8 G_Timer1_Count = 0;
+uint8 Next_Sequence = 0;
 uint8 Counter;
 uint8 PassArr1_Send[PASSWORD_SIZE];
 uint8 PassArr2_Send[PASSWORD_SIZE];
+uint8 G_Option;
+
+/* Last scan of the keypad and the key taken from it (KEYPAD_NO_KEY once released) */
+uint8 G_Last_Scan = KEYPAD_NO_KEY;
+uint8 G_Stable_Key = KEYPAD_NO_KEY;
+
+/* Door state displayed, and whether the next received byte is the door state of a DOOR_STATUS answer */
+uint8 G_Door_State = DOOR_CLOSED;
+boolean G_Status_Pending = FALSE;
+boolean G_Status_Next = FALSE;
+Tick_Type G_Status_Time;
+
+/* Waiting for the link: CONTROL_READY received (the password state is next), and the screen kept once answered */
+boolean G_Link_Answered = FALSE;
+boolean G_Link_Keep_Message = FALSE;
+
+/* Software timers of the keypad, the messages, the door status, the lockout and the hello, on the timer wheel */
+TimerWheel_TimerType G_Keypad_Timer;
+TimerWheel_TimerType G_Message_Timer;
+TimerWheel_TimerType G_Status_Timer;
+TimerWheel_TimerType G_Lockout_Timer;
+TimerWheel_TimerType G_Display_Timer;
+TimerWheel_TimerType G_Hello_Timer;
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -59,25 +162,133 @@ uint8 PassArr2_Send[PASSWORD_SIZE];
 
 /*
  * Description:
- * Function is responsible to be called when Timer1 interrupt occurs to increment the ticks by one.
+ * Functions are responsible to be called from the timer wheel and the UART interrupt to post their events.
+ */
+void KeypadTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_KEYPAD_SCAN, 0);
+}
+
+void UartReceive_CallBack(void)
+{
+	Scheduler_Post(EVENT_UART_RECEIVED, 0);
+}
+
+void MessageTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_MESSAGE_TIMER, 0);
+}
+
+void StatusTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_STATUS_TIMER, 0);
+}
+
+void LockoutTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_LOCKOUT_TIMER, 0);
+}
+
+void DisplayTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_DISPLAY_TIMER, 0);
+}
+
+void HelloTimer_CallBack(void)
+{
+	Scheduler_Post(EVENT_HELLO_TIMER, 0);
+}
+
+/*
+ * Description:
+ * Function is responsible for receiving the next byte of an exchange with Control ECU, LINK_TIMEOUT_MS at most
+ * after Start. Returns FALSE on a timeout.
  */
-void Timer1_CallBack(void)
+boolean ReceiveLinkByte(uint8 *Byte, Tick_Type Start)
 {
-	/* Every three seconds, it increments by one */
-	G_Timer1_Count++;
+	Tick_Type Elapsed = Tick_Elapsed(Start);
+
+	/* A bounded wait is no hang */
+	Watchdog_Checkpoint(HMI_ECU_Sequence);
+
+	return ((Elapsed < LINK_TIMEOUT_MS) && UART_ReceiveByteTimeout(Byte, (uint16)(LINK_TIMEOUT_MS - Elapsed)));
+}
+
+/*
+ * Description:
+ * Function is responsible for waiting for the given byte from Control ECU, the other bytes are dropped.
+ * Returns FALSE if it didn't come within LINK_TIMEOUT_MS.
+ */
+boolean WaitLinkByte(uint8 Expected)
+{
+	Tick_Type Start = Tick_Now();
+	uint8 Byte;
+
+	do
+	{
+		if (!ReceiveLinkByte(&Byte, Start))
+		{
+			return FALSE;
+		}
+	}while (Byte != Expected);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Function is responsible for starting an exchange with Control ECU: the bytes waiting are stale (the answer to
+ * a hello of a reset) and dropped, then HMI_READY is sent and CONTROL_READY awaited.
+ * Returns FALSE if Control ECU didn't answer.
+ */
+boolean StartExchange(void)
+{
+	while (UART_IsByteReceived())
+	{
+		UART_ReceiveByte();
+	}
+
+	UART_SendByte(HMI_READY);
+	return WaitLinkByte(CONTROL_READY);
+}
+
+/*
+ * Description:
+ * Function is responsible for entering the waiting for the link step: hello is said to Control ECU now and every
+ * HMI_HELLO_MS until it answers (LinkAnswered), the LCD keeps what the caller displayed and the keypad is scanned.
+ * Keep_Message: the screen stays MESSAGE_MS more once answered.
+ */
+void ConnectControl(boolean Keep_Message)
+{
+	/* The bytes waiting belong to an exchange given up */
+	while (UART_IsByteReceived())
+	{
+		UART_ReceiveByte();
+	}
+
+	G_Link_Answered = FALSE;
+	G_Link_Keep_Message = Keep_Message;
+	HMI_ECU_Sequence = WAITING_LINK;
+
+	/* Control ECU may be booting still, or blocked in a step: repeat the hello until CONTROL_READY comes */
+	UART_SendByte(HMI_HELLO);
+	TimerWheel_Start(&G_Hello_Timer, HMI_HELLO_MS, HMI_HELLO_MS, HelloTimer_CallBack);
 }
 
 /*
  * Description:
  * Function is responsible for sending the entered password to Control ECU.
+ * Returns FALSE if Control ECU didn't answer.
  */
-void SendPassword(uint8 *pass_Ptr1)
+boolean SendPassword(uint8 *pass_Ptr1)
 {
 	uint8 i;
 
 	/* Coordinate data transmit with another ECU */
-	UART_SendByte(HMI_READY);
-	while (UART_ReceiveByte()!= CONTROL_READY);
+	if (!StartExchange())
+	{
+		return FALSE;
+	}
 
 	/* Send the password to Control_ECU number by number */
 	for(i = 0; i < PASSWORD_SIZE; i++)
@@ -86,435 +297,622 @@ void SendPassword(uint8 *pass_Ptr1)
 	}
 
 	/* wait until the byte received  Control_ECU */
-	while(UART_ReceiveByte() != PASS_RECEIVED);
+	return WaitLinkByte(PASS_RECEIVED);
 }
 
 /*
  * Description:
- * This function is responsible for Entering the password of five integers.
+ * Function is responsible for receiving the result of the password sent to Control ECU.
+ * Returns FALSE if Control ECU didn't answer.
  */
-void EnterPassword(void)
+boolean ReceiveResult(uint8 *Result)
 {
-	/* Clear anything on the LCD Screen */
-	LCD_ClearString();
-
-	/* Display this message to let the user enter the password */
-	LCD_DisplayString("Plz Enter Pass: ");
-
-	/* Move Cursor to the next row to write the password */
-	LCD_MoveCursor(1,0);
-
-	/* Let the user enter only 5 numbers & store the password in the array of integers */
-	for (Counter = 0; Counter < PASSWORD_SIZE; Counter++)
+	/* Coordinate data transmit with another ECU */
+	if (!WaitLinkByte(CONTROL_READY))
 	{
-		Key_Pressed = KEYPAD_GetPressedKey();
-
-		if (Key_Pressed >= 0 && Key_Pressed <= 9)
-		{
-			LCD_DisplayCharacter('*');
-			PassArr1_Send[Counter] = Key_Pressed;
-		}
-		else
-		{
-			/*
-			 * The counter decreases by one then increases by one to be the same to ensure that exactly five
-			 * numbers are entered.
-			 */
-			Counter--;
-		}
+		return FALSE;
 	}
+	UART_SendByte(HMI_READY);
+
+	return ReceiveLinkByte(Result, Tick_Now());
+}
 
-	/* The application waits the user to enter '=' (Enter Key) to continue */
-	while (Key_Pressed != '=')
+/*
+ * Description:
+ * Function is responsible for displaying a message for 2 seconds then going to the Next step.
+ * Line2 may be NULL_PTR.
+ */
+void ShowMessage(const char *Line1, const char *Line2, uint8 Next)
+{
+	/* Clear anything on the LCD Screen */
+	LCD_ClearString();
+
+	LCD_DisplayString(Line1);
+	if (Line2 != NULL_PTR)
 	{
-		/* Let the user press enter '=' to save the password */
-		Key_Pressed = KEYPAD_GetPressedKey();
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString(Line2);
 	}
 
-	/* Send the First Password to Control_ECU */
-	SendPassword(PassArr1_Send);
+	Next_Sequence = Next;
+	HMI_ECU_Sequence = SHOWING_MESSAGE;
+	TimerWheel_Start(&G_Message_Timer, MESSAGE_MS, 0, MessageTimer_CallBack);
 }
 
 /*
  * Description:
- * This function is responsible for entering confirmed password and sending it to Control ECU.
+ * Function is responsible for displaying the link error at once after an exchange timed out (Control ECU was
+ * reset or is blocked), then connecting to Control ECU again.
  */
-void ConfirmPassword(void)
+void Resynchronize(void)
 {
-	/* Clear anything on the LCD Screen */
-	LCD_ClearString();
+	TimerWheel_Stop(&G_Message_Timer);
+	TimerWheel_Stop(&G_Status_Timer);
+	TimerWheel_Stop(&G_Lockout_Timer);
+	TimerWheel_Stop(&G_Display_Timer);
 
-	/* Once the user entered the enter press '=', display the following on the LCD Screen */
-	LCD_DisplayString("Plz re-enter the");
+	LCD_ClearString();
+	LCD_DisplayString("ERROR! Link");
 	LCD_MoveCursor(1,0);
-	LCD_DisplayString("Same Pass: ");
-	LCD_MoveCursor(1,11);
+	LCD_DisplayString("Waiting...");
 
-	/* Let the user enter only 5 numbers & store the password in the array of integers */
-	for (Counter = 0; Counter < PASSWORD_SIZE; Counter++)
-	{
-		Key_Pressed = KEYPAD_GetPressedKey();
+	ConnectControl(TRUE);
+}
+
+/*
+ * Description:
+ * Function is responsible for taking the action of the password result of an option or of a new password.
+ */
+void PasswordResult(uint8 Result)
+{
+	uint8 Attempts_Left;
 
-		if (Key_Pressed >= 0 && Key_Pressed <= 9)
+	if (HMI_ECU_Sequence == CONFIRM_PASSWORD)
+	{
+		if (Result == PASSWORDS_MATCHED)
 		{
-			LCD_DisplayCharacter('*');
-			PassArr2_Send[Counter] = Key_Pressed;
+			/* Print that the passwords are matched, then jump to the next step */
+			ShowMessage("Done!", "Password Saved", MAIN_OPTIONS_DISPLAY);
+		}
+		else if (Result == STORAGE_FAILURE)
+		{
+			/* The password couldn't be saved, this is not counted as a wrong attempt */
+			ShowMessage("ERROR! Memory", "Try Again", ENTER_PASSWORD);
 		}
 		else
 		{
-			/*
-			 * if any key pressed other than [0 : 9] -> the counter decreases by one then increases by one to be the same
-			 * to ensure that exactly five digits are entered.
-			 */
-			Counter--;
+			/* Print that the passwords are not matched, then return to first step */
+			ShowMessage("ERROR! Passwords", "Not Matched", ENTER_PASSWORD);
 		}
 	}
-
-	/* The application waits the user to enter '=' (Enter Key) to continue */
-	while (Key_Pressed != '=')
+	else if (Result == PASSWORDS_MATCHED)
 	{
-		/* Let the user press enter '=' to save the password */
-		Key_Pressed = KEYPAD_GetPressedKey();
+		/* Jump to Opening Door step or to Changing Password step */
+		ShowMessage("Successful!", NULL_PTR, (G_Option == '+') ? OPENING_DOOR : ENTER_PASSWORD);
+	}
+	else if (Result == STORAGE_FAILURE)
+	{
+		/* The saved password couldn't be read */
+		ShowMessage("ERROR! Memory", "Try Again", MAIN_OPTIONS_DISPLAY);
+	}
+	else if (ReceiveLinkByte(&Attempts_Left, Tick_Now()))
+	{
+		/* Control ECU keeps the wrong attempts, it sends how many are left before the lockout */
+		ShowMessage("ERROR!", "Wrong Password", (Attempts_Left == 0) ? PASSWORD_ERROR : MAIN_OPTIONS_DISPLAY);
+	}
+	else
+	{
+		Resynchronize();
 	}
-
-	/* Send the Second Password to Control_ECU */
-	SendPassword(PassArr2_Send);
 }
 
 /*
  * Description:
- * This function is responsible for
- * 1. Displaying the main options (+ : Open Door or - : Change Pass)
- * 2. Let the user select one option.
+ * Function is responsible for entering a step and taking its first action, the next events finish it.
  */
-void MainOptions(void)
+void EnterSequence(uint8 Sequence)
 {
+	uint8 Lockout_Periods;
+
+	HMI_ECU_Sequence = Sequence;
+
 	/* Clear anything on the LCD Screen */
 	LCD_ClearString();
 
-	/* The Main Options should be displayed on the LCD Screen as following: */
-	LCD_DisplayString("+ : Open Door ");
-	LCD_MoveCursor(1,0);
-	LCD_DisplayString("- : Change Pass ");
-
-	/* if '+' or '-' buttons are not pressed, then nothing happens until any of them pressed by user */
-	while ((Key_Pressed != '+') && (Key_Pressed != '-'))
+	switch(Sequence)
 	{
-		/* Press '+' to open the door or Press '-' to change pass */
-		Key_Pressed = KEYPAD_GetPressedKey();
-	}
-}
 
-/********************************************************************************************************
- *                                                                                                      *
- *                                             * HMI Main Function *                                    *
- *                                                                                                      *
- ********************************************************************************************************/
+	/* Let the user enter a password of five digits */
+	case ENTER_PASSWORD:
+	case ENTER_OPTION_PASSWORD:
 
-int main(void)
-{
-	uint8 Result;
-	uint8 i;
+		/* Display this message to let the user enter the password */
+		LCD_DisplayString("Plz Enter Pass: ");
 
-	/********************************************************************************************************
-	 *                                                                                                      *
-	 *                                         * Drivers Configurations *                                   *
-	 *                                                                                                      *
-	 ********************************************************************************************************/
+		/* Move Cursor to the next row to write the password */
+		LCD_MoveCursor(1,0);
+		Counter = 0;
+		break;
 
-	/*
-	 * Timer1 Normal Mode Configuration:
-	 * 1. TCNT1 = 0 -> Starting Value of Timer is Zero.
-	 * 2. OCR1A = 24000 -> Every 24000 ticks, the timer counts "three seconds".
-	 * 3. Pre-scalar = F_CPU/1024 -> (Tick time = 0.125 msec, so (Timer Time / Tick Time = No. of ticks)
-	 * 4. Timer1 Mode -> CTC Mode.
-	 */
-	Timer1_ConfigType Timer1_Config = {0, 24000, TIMER1_Prescaler_1024, TIMER1_CTC_4};
+		/* Let the user enter the confirmed password */
+	case CONFIRM_PASSWORD:
 
-	/*
-	 * UART Configuration:
-	 * 1. UART Mode -> Asynchronous Mode.
-	 * 2. Data Transmission Speed Mode -> Double Speed Mode.
-	 * 3. Parity Bit State -> Disabled.
-	 * 4. Data Size in Bits -> Eight bits.
-	 * 5. Baud Rate -> 9600.
-	 */
-	UART_ConfigType UART_Config = {Asynchronous, Double_Speed, Disabled, 0, Eight_Bit_3, 9600};
+		LCD_DisplayString("Plz re-enter the");
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString("Same Pass: ");
+		LCD_MoveCursor(1,11);
+		Counter = 0;
+		break;
 
-	/********************************************************************************************************
-	 *                                                                                                      *
-	 *                                           * Drivers Initialization *                                 *
-	 *                                                                                                      *
-	 ********************************************************************************************************/
+		/* Display the main options and let user choose between open the door or change password */
+	case MAIN_OPTIONS_DISPLAY:
 
-	/* MCAL Drivers Initialization */
-	UART_Init(&UART_Config);
+		/* The Main Options should be displayed on the LCD Screen as following: */
+		LCD_DisplayString("+ : Open Door ");
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString("- : Change Pass ");
 
-	/* HAL Drivers initialization */
-	LCD_Init();
+		/* Press '+' to open the door or Press '-' to change pass */
+		HMI_ECU_Sequence = MAIN_OPTION_SELECTION;
+		break;
 
-	/* Activation of Global Interrupt enable bit (I-bit) to enable the interrupts */
-	SREG |= (1<<7);
+		/* Display the messages of door locking/unlocking on lCD screen */
+	case OPENING_DOOR:
+
+		/* Coordinate data transmit with another ECU */
+		if (!StartExchange())
+		{
+			Resynchronize();
+			break;
+		}
 
-	/* Wait until Control_ECU is ready to receive the data */
-	while(UART_ReceiveByte() != CONTROL_READY){}
+		/* Send to Control ECU to open the door */
+		UART_SendByte(OPEN_THE_DOOR);
 
-	/********************************************************************************************************
-	 *                                                                                                      *
-	 *                                           * HMI Application Sequence *                               *
-	 *                                                                                                      *
-	 ********************************************************************************************************/
+		LCD_DisplayString("Door is");
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString("Unlocking...");
 
-	while (1)
-	{
-		switch(HMI_ECU_Sequence)
+		/* Follow the door state of Control ECU until the door is closed, ON/C stops it */
+		G_Door_State = DOOR_OPENING;
+		G_Status_Pending = FALSE;
+		G_Status_Next = FALSE;
+		TimerWheel_Start(&G_Status_Timer, STATUS_POLL_MS, STATUS_POLL_MS, StatusTimer_CallBack);
+
+		/* A byte already waiting in the buffer raises no event */
+		if (UART_IsByteReceived())
 		{
+			Scheduler_Post(EVENT_UART_RECEIVED, 0);
+		}
+		break;
 
-		/* Let the user enter the first password */
-		case ENTER_PASSWORD:
+		/* Display message of Error on LCD screen if the user entered the password three failed attempts */
+	case PASSWORD_ERROR:
 
-			/* Start the Application by letting the user enter the password */
-			EnterPassword();
+		/* Coordinate data transmit with another ECU (Control ECU started it entering the lockout) */
+		if (!WaitLinkByte(CONTROL_READY))
+		{
+			Resynchronize();
+			break;
+		}
+		UART_SendByte(HMI_READY);
 
-			/* Jump to the next step */
-			HMI_ECU_Sequence++;
+		/* Wait until Control ECU Sends to display Error message on LCD Screen, then the lockout periods left */
+		if (!WaitLinkByte(DISPLAY_ERROR) || !ReceiveLinkByte(&Lockout_Periods, Tick_Now()))
+		{
+			Resynchronize();
 			break;
+		}
 
-			/* Let the user enter the confirmed password and save it if it matched with first one */
-		case CONFIRM_PASSWORD:
+		LCD_DisplayString("ERROR Happened!");
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString("Try Again in");
+
+		/*
+		 * The lockout lasts one minute (4 periods, less if the lock was reset during it), the seconds left are
+		 * displayed every second
+		 */
+		TimerWheel_Start(&G_Lockout_Timer, Lockout_Periods * LOCKOUT_PERIOD_MS, 0, LockoutTimer_CallBack);
+		TimerWheel_Start(&G_Display_Timer, 1, DISPLAY_REFRESH_MS, DisplayTimer_CallBack);
+		break;
+
+		/* if any thing entered except the sequence steps of application -> display error message */
+	default:
+
+		LCD_DisplayString("ERROR Happened!");
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString("Try Again Later");
+		while (1);
+	}
+}
 
-			/* Let the user confirm the password */
-			ConfirmPassword();
+/*
+ * Description:
+ * Function is responsible for leaving the waiting for the link step once Control ECU sent its password state,
+ * to the step it tells. Returns FALSE if the byte is no password state.
+ */
+boolean LinkAnswered(uint8 Result)
+{
+	uint8 Next;
 
-			/* Coordinate data transmit with another ECU */
-			while (UART_ReceiveByte()!= CONTROL_READY);
-			UART_SendByte(HMI_READY);
+	/* If the password survived the last power cycle, go directly to the main options (or finish the lockout) */
+	if (Result == PASSWORD_STORED)
+	{
+		Next = MAIN_OPTIONS_DISPLAY;
+	}
+	else if (Result == PASSWORD_LOCKED)
+	{
+		Next = PASSWORD_ERROR;
+	}
+	else if (Result == NO_PASSWORD_STORED)
+	{
+		Next = ENTER_PASSWORD;
+	}
+	else
+	{
+		return FALSE;
+	}
 
-			if (UART_ReceiveByte() == PASSWORDS_MATCHED)
-			{
-				/* Clear anything on the LCD Screen */
-				LCD_ClearString();
+	TimerWheel_Stop(&G_Hello_Timer);
 
-				/* Print that the passwords are matched */
-				LCD_DisplayString("Done!");
-				LCD_MoveCursor(1,0);
-				LCD_DisplayString("Password Saved");
-				_delay_ms(2000);
+	/* The lockout exchange Control ECU started can't wait for the message */
+	if (G_Link_Keep_Message && (Next != PASSWORD_ERROR))
+	{
+		Next_Sequence = Next;
+		HMI_ECU_Sequence = SHOWING_MESSAGE;
+		TimerWheel_Start(&G_Message_Timer, MESSAGE_MS, 0, MessageTimer_CallBack);
+	}
+	else
+	{
+		EnterSequence(Next);
+	}
 
-				/* Jump to the next step */
-				HMI_ECU_Sequence++;
-			}
-			else
-			{
-				/* Clear anything on the LCD Screen */
-				LCD_ClearString();
+	return TRUE;
+}
 
-				/* Print that the passwords are not matched */
-				LCD_DisplayString("ERROR! Passwords");
-				LCD_MoveCursor(1,0);
-				LCD_DisplayString("Not Matched");
-				_delay_ms(2000);
+/*
+ * Description:
+ * Function is responsible for displaying the door state received from Control ECU while the door moves.
+ */
+void DisplayDoorState(uint8 State)
+{
+	boolean Locking = (State == DOOR_CLOSING);
 
-				/* return to first step */
-				HMI_ECU_Sequence = ENTER_PASSWORD;
-			}
-			break;
+	if ((State == DOOR_CLOSED) || (State == DOOR_STOPPED))
+	{
+		TimerWheel_Stop(&G_Status_Timer);
 
-			/* Display the main options and let user choose between open the door or change password */
-		case MAIN_OPTIONS_DISPLAY:
+		if (State == DOOR_STOPPED)
+		{
+			ShowMessage("Door Stopped", NULL_PTR, MAIN_OPTIONS_DISPLAY);
+		}
+		else
+		{
+			EnterSequence(MAIN_OPTIONS_DISPLAY);
+		}
+		return;
+	}
 
-			/* Display Main Options */
-			MainOptions();
+	/* Display the message again only when it changes */
+	if (Locking != (G_Door_State == DOOR_CLOSING))
+	{
+		LCD_MoveCursor(1,0);
+		LCD_DisplayString(Locking ? "Locking...  " : "Unlocking...");
+	}
 
-			/* Coordinate data transmit with another ECU */
-			UART_SendByte(HMI_READY);
-			while (UART_ReceiveByte()!= CONTROL_READY);
+	G_Door_State = State;
+}
 
-			/* Send the pressed key whether is '+' or '-' to Control ECU */
-			UART_SendByte(Key_Pressed);
+/*
+ * Description:
+ * Function is responsible for taking the action of a pressed key in the current step.
+ */
+void KeyPressed(uint8 Key)
+{
+	uint8 *Pass = (HMI_ECU_Sequence == CONFIRM_PASSWORD) ? PassArr2_Send : PassArr1_Send;
+	uint8 Result;
+
+	switch(HMI_ECU_Sequence)
+	{
+	case ENTER_PASSWORD:
+	case CONFIRM_PASSWORD:
+	case ENTER_OPTION_PASSWORD:
 
-			if (Key_Pressed == '+')
+		/* Only five digits are taken, then the application waits the user to enter '=' (Enter Key) */
+		if ((Key <= 9) && (Counter < PASSWORD_SIZE))
+		{
+			LCD_DisplayCharacter('*');
+			Pass[Counter] = Key;
+			Counter++;
+		}
+		else if ((Key == '=') && (Counter == PASSWORD_SIZE))
+		{
+			if (!SendPassword(Pass))
+			{
+				Resynchronize();
+			}
+			else if (HMI_ECU_Sequence == ENTER_PASSWORD)
+			{
+				/* Jump to the next step */
+				EnterSequence(CONFIRM_PASSWORD);
+			}
+			else if (ReceiveResult(&Result))
 			{
-				/* Let the user enter the password */
-				EnterPassword();
-
-				/* Coordinate data transmit with another ECU */
-				while (UART_ReceiveByte()!= CONTROL_READY);
-				UART_SendByte(HMI_READY);
-
-				if (UART_ReceiveByte() == PASSWORDS_MATCHED)
-				{
-					/* Clear anything on the LCD Screen */
-					LCD_ClearString();
-
-					/* Print that the password are successfully entered */
-					LCD_DisplayString("Successful!");
-					_delay_ms(2000);
-
-					/* Jump to Opening Door step */
-					HMI_ECU_Sequence = OPENING_DOOR;
-				}
-				else
-				{
-					/* Clear anything on the LCD Screen */
-					LCD_ClearString();
-
-					/* Print that the passwords are not matched */
-					LCD_DisplayString("ERROR!");
-					LCD_MoveCursor(1,0);
-					LCD_DisplayString("Wrong Password");
-					_delay_ms(2000);
-
-					/* increment of the wrong attempts */
-					i++;
-
-					/* return to main options display step */
-					HMI_ECU_Sequence = MAIN_OPTIONS_DISPLAY;
-				}
+				PasswordResult(Result);
 			}
 			else
 			{
-				/* Let the user enter the password */
-				EnterPassword();
-
-				/* Coordinate data transmit with another ECU */
-				while (UART_ReceiveByte()!= CONTROL_READY);
-				UART_SendByte(HMI_READY);
-
-				if (UART_ReceiveByte() == PASSWORDS_MATCHED)
-				{
-					/* Clear anything on the LCD Screen */
-					LCD_ClearString();
-
-					/* Print that the password are successfully entered */
-					LCD_DisplayString("Successful!");
-					_delay_ms(2000);
-
-					/* Jump to Changing Password step */
-					HMI_ECU_Sequence = ENTER_PASSWORD;
-				}
-				else
-				{
-					/* Clear anything on the LCD Screen */
-					LCD_ClearString();
-
-					/* Print that the passwords are not matched */
-					LCD_DisplayString("ERROR!");
-					LCD_MoveCursor(1,0);
-					LCD_DisplayString("Wrong Password");
-					_delay_ms(2000);
-
-					/* increment of the wrong attempts */
-					i++;
-
-					/* return to main options display step */
-					HMI_ECU_Sequence = MAIN_OPTIONS_DISPLAY;
-				}
+				Resynchronize();
 			}
+		}
+		break;
+
+	case MAIN_OPTION_SELECTION:
 
-			/* take an action if the wrong attempts reach 3 attempts */
-			if (i == 3)
+		/* if '+' or '-' buttons are not pressed, then nothing happens until any of them pressed by user */
+		if ((Key == '+') || (Key == '-'))
+		{
+			/* Coordinate data transmit with another ECU */
+			if (!StartExchange())
 			{
-				/* Jump to Password Error Step */
-				HMI_ECU_Sequence = PASSWORD_ERROR;
-				i = 0;
+				Resynchronize();
+				break;
 			}
-			break;
 
-			/* Display the messages of door locking/unlocking on lCD screen */
-		case OPENING_DOOR:
+			/* Send the pressed key whether is '+' or '-' to Control ECU */
+			UART_SendByte(Key);
+			G_Option = Key;
 
-			/* Coordinate data transmit with another ECU */
-			UART_SendByte(HMI_READY);
-			while (UART_ReceiveByte()!= CONTROL_READY);
+			/* Let the user enter the password */
+			EnterSequence(ENTER_OPTION_PASSWORD);
+		}
+#ifdef PROFILE_ENABLE
+		else if (Key == PROFILE_DUMP_KEY)
+		{
+			UART_SendByte(PROFILE_FRAME_START);
+			Profile_Dump(UART_SendByte);
+			UART_SendByte(PROFILE_FRAME_END);
+		}
+#endif
+		break;
+
+	case OPENING_DOOR:
+	case WAITING_LINK:
+
+		/* The link may be lost while the door moves */
+		if (Key == EMERGENCY_KEY)
+		{
+			UART_SendByte(EMERGENCY_STOP);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for taking a key when two scans in a row see it, once per press.
+ */
+void ScanKeypad(void)
+{
+	uint8 Key;
+
+	PROFILE_ENTER(PROFILE_KEYPAD_SCAN);
+	Key = KEYPAD_Scan();
+	PROFILE_EXIT(PROFILE_KEYPAD_SCAN);
+
+	if ((Key == G_Last_Scan) && (Key != G_Stable_Key))
+	{
+		G_Stable_Key = Key;
+
+		if (Key != KEYPAD_NO_KEY)
+		{
+			KeyPressed(Key);
+		}
+	}
+
+	G_Last_Scan = Key;
+}
 
-			/* Send to Control ECU to open the door */
-			UART_SendByte(OPEN_THE_DOOR);
+/*
+ * Description:
+ * Function is responsible for handling the bytes received from Control ECU while the door moves or the link is
+ * awaited, the other steps read their answers when they expect them.
+ */
+void ReceiveStatus(void)
+{
+	uint8 Byte;
 
-			/* Start the timer */
-			Timer1_NonPWm_Mode_Init(&Timer1_Config);
-			Timer1_SetCallBack(Timer1_CallBack);
+	while (((HMI_ECU_Sequence == OPENING_DOOR) || (HMI_ECU_Sequence == WAITING_LINK)) && UART_IsByteReceived())
+	{
+		Byte = UART_ReceiveByte();
 
-			/* Clear anything on the LCD Screen */
-			LCD_ClearString();
+		if (HMI_ECU_Sequence == WAITING_LINK)
+		{
+			/* CONTROL_READY then the password state, the next bytes are left to the step entered */
+			if (!G_Link_Answered || !LinkAnswered(Byte))
+			{
+				G_Link_Answered = (Byte == CONTROL_READY);
+			}
+		}
+		else if (G_Status_Next)
+		{
+			G_Status_Next = FALSE;
+			G_Status_Pending = FALSE;
+			DisplayDoorState(Byte);
+		}
+		else if (Byte == DOOR_STATUS)
+		{
+			G_Status_Next = TRUE;
+		}
+	}
+}
+
+/*
+ * Description:
+ * Function is responsible for handling the scheduler events, it returns as soon as the event is handled.
+ */
+void HMITask(const Scheduler_EventType *Event)
+{
+	switch (Event -> Type)
+	{
+	case EVENT_KEYPAD_SCAN:
+		ScanKeypad();
+		break;
 
-			/* Print that the passwords are not matched */
-			LCD_DisplayString("Door is");
-			LCD_MoveCursor(1,0);
-			LCD_DisplayString("Unlocking...");
+	case EVENT_UART_RECEIVED:
+		ReceiveStatus();
+		break;
 
-			/* every tick = 3 seconds, so:
-			 * 1. Opening the door time = 3*5 = 15 seconds
-			 * 2. Holding the door time = 3*1 = 3 seconds
-			 * Total time = 18 seconds which is G_Timer1_Count = 18/3 = 6 ticks */
-			while (G_Timer1_Count < 6);
+	case EVENT_MESSAGE_TIMER:
+		if (HMI_ECU_Sequence == SHOWING_MESSAGE)
+		{
+			EnterSequence(Next_Sequence);
+		}
+		break;
 
-			/* Start count again from 0 */
-			G_Timer1_Count = 0;
+	case EVENT_STATUS_TIMER:
 
-			/* Clear anything on the LCD Screen */
-			LCD_ClearString();
+		/* One query at a time, the answer of the last one closes the door step */
+		if ((HMI_ECU_Sequence == OPENING_DOOR) && !G_Status_Pending)
+		{
+			G_Status_Pending = TRUE;
+			G_Status_Time = Tick_Now();
+			UART_SendByte(STATUS_QUERY);
+		}
+		else if ((HMI_ECU_Sequence == OPENING_DOOR) && (Tick_Elapsed(G_Status_Time) >= LINK_TIMEOUT_MS))
+		{
+			/* A query never answered: Control ECU was reset while the door moved */
+			Resynchronize();
+		}
+		break;
 
-			/* Print that the passwords are not matched */
-			LCD_DisplayString("Door is");
-			LCD_MoveCursor(1,0);
-			LCD_DisplayString("Locking...");
+	case EVENT_HELLO_TIMER:
+		if (HMI_ECU_Sequence == WAITING_LINK)
+		{
+			UART_SendByte(HMI_HELLO);
+		}
+		break;
 
-			/* Wait another 15 seconds (3 seconds * 5 ticks) */
-			while (G_Timer1_Count < 5);
+	case EVENT_DISPLAY_TIMER:
+		if (HMI_ECU_Sequence == PASSWORD_ERROR)
+		{
+			LCD_MoveCursor(1,13);
+			LCD_IntegerToString((TimerWheel_GetRemaining(&G_Lockout_Timer) + 999) / 1000);
+			LCD_DisplayCharacter(' ');
+		}
+		break;
 
-			/* Stop the timer */
-			G_Timer1_Count = 0;
-			Timer1_DeInit();
+	case EVENT_LOCKOUT_TIMER:
+		if (HMI_ECU_Sequence == PASSWORD_ERROR)
+		{
+			TimerWheel_Stop(&G_Display_Timer);
 
 			/* return to main options display step */
-			HMI_ECU_Sequence = MAIN_OPTIONS_DISPLAY;
-			break;
+			EnterSequence(MAIN_OPTIONS_DISPLAY);
+		}
+		break;
 
-			/* Display message of Error on LCD screen if the user entered the password three failed attempts */
-		case PASSWORD_ERROR:
+	default:
+		break;
+	}
 
-			/* Coordinate data transmit with another ECU */
-			while (UART_ReceiveByte()!= CONTROL_READY);
-			UART_SendByte(HMI_READY);
+	/*
+	 * The next event is checked against the budget of the step reached (SCHEDULER_DEFAULT_BUDGET_MS, the
+	 * Scheduler_GetStatistics overruns show the slow steps), and the time until then charged to it
+	 */
+	Scheduler_SetState(HMI_ECU_Sequence);
+}
 
-			/* Wait until Control ECU Sends to display Error message on LCD Screen */
-			while (UART_ReceiveByte()!= DISPLAY_ERROR);
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                             * HMI Main Function *                                    *
+ *                                                                                                      *
+ ********************************************************************************************************/
 
-			/* Start the timer */
-			Timer1_NonPWm_Mode_Init(&Timer1_Config);
-			Timer1_SetCallBack(Timer1_CallBack);
+int main(void)
+{
+	/********************************************************************************************************
+	 *                                                                                                      *
+	 *                                         * Drivers Configurations *                                   *
+	 *                                                                                                      *
+	 ********************************************************************************************************/
 
-			/* Clear anything on the LCD Screen */
-			LCD_ClearString();
+	/*
+	 * UART Configuration:
+	 * 1. UART Mode -> Asynchronous Mode.
+	 * 2. Data Transmission Speed Mode -> Double Speed Mode.
+	 * 3. Parity Bit State -> Disabled.
+	 * 4. Data Size in Bits -> Eight bits.
+	 * 5. Baud Rate -> 9600.
+	 */
+	UART_ConfigType UART_Config = {Asynchronous, Double_Speed, Disabled, 0, Eight_Bit_3, 9600};
 
-			/* Print that the passwords are not matched */
-			LCD_DisplayString("ERROR Happened!");
-			LCD_MoveCursor(1,0);
-			LCD_DisplayString("Try Again Later");
+#ifdef PROFILE_ENABLE
+	/*
+	 * Timer0 Normal Mode Configuration (profiling build only, Timer0 is free on this ECU):
+	 * 1. TCNT0 = 0 -> Starting Value of Timer is Zero.
+	 * 2. Pre-scalar = F_CPU/8 -> 1 usec timestamp resolution at 8 Mhz, an overflow interrupt every 256 usec.
+	 * 3. Timer0 Mode -> Normal Mode.
+	 */
+	Timer0_ConfigType Timer0_Config = {0, 0, TIMER0_PRESCALER(8), TIMER0_Normal_0};
+#endif
 
-			/* wait one minute (60 seconds = 3 seconds * 20 ticks ) */
-			while (G_Timer1_Count < 20);
+	/********************************************************************************************************
+	 *                                                                                                      *
+	 *                                           * Drivers Initialization *                                 *
+	 *                                                                                                      *
+	 ********************************************************************************************************/
 
-			/* Stop the timer */
-			G_Timer1_Count = 0;
-			Timer1_DeInit();
+	/* A hang of any step below resets the HMI within WATCHDOG_PERIOD, the stuck step is kept */
+	Watchdog_Init();
+	Watchdog_Checkpoint(BOOT_DRIVERS);
 
-			/* return to main options display step */
-			HMI_ECU_Sequence = MAIN_OPTIONS_DISPLAY;
-			break;
+	/* MCAL Drivers Initialization */
+	UART_Init(&UART_Config);
 
-			/* if any thing entered except the sequence steps of application -> display error message */
-		default:
+	/* HAL Drivers initialization */
+	LCD_Init();
 
-			/* Clear anything on the LCD Screen */
-			LCD_ClearString();
+	/* Activation of Global Interrupt enable bit (I-bit) to enable the interrupts */
+	SREG |= (1<<7);
 
-			/* Print that the passwords are not matched */
-			LCD_DisplayString("ERROR Happened!");
-			LCD_MoveCursor(1,0);
-			LCD_DisplayString("Try Again Later");
-			while (1);
-		}
+	/* 1 msec time base of the display timings (Timer2), it drives the software timers too */
+	Tick_Init();
+	TimerWheel_Init();
+
+#ifdef PROFILE_ENABLE
+	/* Profiling build: the durations are measured with the Timer0 timestamp (1 usec), the dumps are dropped */
+	Timer0_NonPWM_Mode_Init(&Timer0_Config);
+	Profile_Init(Timer0_GetTimestamp, 0);
+	UART_SetIgnoredFrame(PROFILE_FRAME_START, PROFILE_FRAME_END);
+#endif
+
+	/* Every step below runs from the events of the keypad, the UART and the software timers, sleeping in between */
+	Power_Init();
+	Scheduler_Init();
+	Scheduler_AddTask(HMITask);
+	UART_SetCallBack(UartReceive_CallBack);
+	TimerWheel_Start(&G_Keypad_Timer, KEYPAD_SCAN_MS, KEYPAD_SCAN_MS, KeypadTimer_CallBack);
+
+	/********************************************************************************************************
+	 *                                                                                                      *
+	 *                                           * HMI Application Sequence *                               *
+	 *                                                                                                      *
+	 ********************************************************************************************************/
+
+	/* Show the step stuck before the last watchdog reset first, until Control ECU answered and MESSAGE_MS more */
+	if (Watchdog_WasReset())
+	{
+		LCD_DisplayString("Watchdog Reset");
+		LCD_DisplayStringRowColumn(1, 0, "Stage ");
+		LCD_IntegerToString(Watchdog_GetRecord() -> Stage);
 	}
+
+	/* Wait until Control_ECU is ready to receive the data, it answers the hello in any step */
+	ConnectControl(Watchdog_WasReset());
+	Scheduler_SetState(HMI_ECU_Sequence);
+	Scheduler_Run();
 }
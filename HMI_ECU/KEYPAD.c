@@ -7,6 +7,7 @@
 #include <util/delay.h>
 #include "KEYPAD.h"
 #include "GPIO.h"
+#include "Profile.h"
 
 /****************************************************************************************
  *                                     Functions Definitions                            *
@@ -35,7 +36,12 @@ static uint8 KEYPAD_4x4_AdjustKeyNumber(uint8 Pressed_Button);
 
 #endif /* KEYPAD4x4Eta32mini */
 
-uint8 KEYPAD_GetPressedKey(void)
+/*
+ * Description:
+ * Scan every row once and return the pressed key, or KEYPAD_NO_KEY if no key is pressed (no waiting, no
+ * debouncing: the caller scans periodically and keeps a key seen on two scans in a row).
+ */
+uint8 KEYPAD_Scan(void)
 {
 	uint8 row;
 	uint8 col;
@@ -55,36 +61,57 @@ uint8 KEYPAD_GetPressedKey(void)
 	GPIO_SetupPinDirection(KEYPAD_COLUMNS_PORT_ID, KEYPAD_COL3_PIN_ID, INPUT_PIN);
 #endif
 
-	while (1)
+	for (row = 0; row < KEYPAD_NUMBER_OF_ROWS; row++)
 	{
-		_delay_ms(200);
-		for (row = 0; row < KEYPAD_NUMBER_OF_ROWS; row++)
-		{
-			GPIO_SetupPinDirection(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, OUTPUT_PIN);
-			GPIO_WritePin(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, LOGIC_LOW);
+		GPIO_SetupPinDirection(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, OUTPUT_PIN);
+		GPIO_WritePin(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, LOGIC_LOW);
 
-			for (col = 0; col < KEYPAD_NUMBER_OF_COLUMNS; col++)
+		for (col = 0; col < KEYPAD_NUMBER_OF_COLUMNS; col++)
+		{
+			if (GPIO_ReadPin(KEYPAD_COLUMNS_PORT_ID, KEYPAD_COL0_PIN_ID + col) == LOGIC_LOW)
 			{
-				if (GPIO_ReadPin(KEYPAD_COLUMNS_PORT_ID, KEYPAD_COL0_PIN_ID + col) == LOGIC_LOW)
-				{
-                    #if (KEYPAD_NUMBER_OF_COLUMNS == 4)
-                         #ifdef KEYPAD4x4Eta32mini
-					            return ((row*KEYPAD_NUMBER_OF_COLUMNS) + col +1);
-                         #else
-					            return KEYPAD_4x4_AdjustKeyNumber((row*KEYPAD_NUMBER_OF_COLUMNS) + col + 1);
-                         #endif
-                    #elif (KEYPAD_NUMBER_OF_COLUMNS == 3)
-                         #ifdef KEYPAD4x4Eta32mini
-					            return ((row*KEYPAD_NUMBER_OF_COLUMNS) + col +1);
-                         #else
-					            return KEYPAD_4x3_AdjustKeyNumber((row*KEYPAD_NUMBER_OF_COLUMNS) + col + 1);
-                         #endif
-                    #endif
-				}
+				/* Release the row before returning, the next scan starts from idle lines */
+				GPIO_SetupPinDirection(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, INPUT_PIN);
+
+                #if (KEYPAD_NUMBER_OF_COLUMNS == 4)
+                     #ifdef KEYPAD4x4Eta32mini
+				            return ((row*KEYPAD_NUMBER_OF_COLUMNS) + col +1);
+                     #else
+				            return KEYPAD_4x4_AdjustKeyNumber((row*KEYPAD_NUMBER_OF_COLUMNS) + col + 1);
+                     #endif
+                #elif (KEYPAD_NUMBER_OF_COLUMNS == 3)
+                     #ifdef KEYPAD4x4Eta32mini
+				            return ((row*KEYPAD_NUMBER_OF_COLUMNS) + col +1);
+                     #else
+				            return KEYPAD_4x3_AdjustKeyNumber((row*KEYPAD_NUMBER_OF_COLUMNS) + col + 1);
+                     #endif
+                #endif
 			}
-			GPIO_SetupPinDirection(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, INPUT_PIN);
 		}
+		GPIO_SetupPinDirection(KEYPAD_ROWS_PORT_ID, KEYPAD_ROW0_PIN_ID+row, INPUT_PIN);
 	}
+
+	return KEYPAD_NO_KEY;
+}
+
+/*
+ * Description:
+ * function to get the pressed key of the Eta32mini KEYPAD or 4x3 and 4x4 Keypads (waits for a key)
+ */
+uint8 KEYPAD_GetPressedKey(void)
+{
+	uint8 Key;
+
+	PROFILE_ENTER(PROFILE_KEYPAD_GET_PRESSED_KEY);
+
+	do
+	{
+		_delay_ms(200);
+		Key = KEYPAD_Scan();
+	} while (Key == KEYPAD_NO_KEY);
+
+	PROFILE_EXIT(PROFILE_KEYPAD_GET_PRESSED_KEY);
+	return Key;
 }
 
 #ifndef KEYPAD4x4Eta32mini
@@ -47,14 +47,24 @@
 #define KEYPAD_COL2_PIN_ID                    PIN6_ID
 #define KEYPAD_COL3_PIN_ID                    PIN7_ID
 
+/* Returned by KEYPAD_Scan when no key is pressed (no key of either keypad has this number) */
+#define KEYPAD_NO_KEY                         0xFF
+
 
 /*******************************************************************************************
  *                                      Functions Prototypes                               *
  *******************************************************************************************/
 /*
  * Description:
- * function to get the pressed key of the Eta32mini KEYPAD or 4x3 and 4x4 Keypads
+ * function to get the pressed key of the Eta32mini KEYPAD or 4x3 and 4x4 Keypads (waits for a key)
  */
 uint8 KEYPAD_GetPressedKey(void);
 
+/*
+ * Description:
+ * Scan every row once and return the pressed key, or KEYPAD_NO_KEY if no key is pressed (no waiting, no
+ * debouncing: the caller scans periodically and keeps a key seen on two scans in a row).
+ */
+uint8 KEYPAD_Scan(void);
+
 #endif /* KEYPAD_H_ */
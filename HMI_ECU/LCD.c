@@ -9,6 +9,7 @@
 #include "LCD.h"
 #include "Common_Macros.h"
 #include "GPIO.h"
+#include "Profile.h"
 
 /****************************************************************************************
  *                                     Functions Definitions                            *
@@ -141,6 +142,8 @@ void LCD_SendCommand(uint8 Command)
  */
 void LCD_DisplayCharacter(uint8 Data)
 {
+	PROFILE_ENTER(PROFILE_LCD_DISPLAY_CHARACTER);
+
 	/* Register Select Pin RS = 1 -> Transferring Data to LCD */
 	GPIO_WritePin(LCD_RS_PORT, LCD_RS_PIN, LOGIC_HIGH);
 
@@ -206,6 +209,8 @@ void LCD_DisplayCharacter(uint8 Data)
 	_delay_ms(1);
 
 #endif
+
+	PROFILE_EXIT(PROFILE_LCD_DISPLAY_CHARACTER);
 }
 
 /*
@@ -0,0 +1,120 @@
+/*****************************************************************************************************************
+ * File Name: Power.c
+ * Date: 18/10/2026
+ * Driver: Idle Sleep and Current Draw Estimate Service Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "Tick.h"
+#include "Power.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Tick counts spent awake and asleep in every state */
+static uint32 g_Awake[POWER_STATES_NUMBER];
+static uint32 g_Asleep[POWER_STATES_NUMBER];
+
+/* State measured now, since when, and its time asleep since then */
+static uint8 g_State = 0;
+static uint32 g_Start = 0;
+static uint32 g_Start_Asleep = 0;
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Select the Idle sleep mode and clear the measurements. Must be called after Tick_Init.
+ */
+void Power_Init(void)
+{
+	uint8 i;
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	for (i = 0; i < POWER_STATES_NUMBER; i++)
+	{
+		g_Awake[i] = 0;
+		g_Asleep[i] = 0;
+	}
+
+	g_State = 0;
+	g_Start = Tick_NowCounts();
+	g_Start_Asleep = 0;
+}
+
+/*
+ * Description:
+ * Sleep until the next interrupt and measure the time asleep. Must be called with the interrupts disabled
+ * (after checking that there is nothing to do), returns with the interrupts enabled.
+ */
+void Power_Sleep(void)
+{
+	uint32 Start = Tick_NowCounts();
+
+	/* SEI takes effect after the next instruction: no interrupt can slip in between and be slept through */
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+	/* The waking interrupt has been served, its time is counted asleep */
+	g_Start_Asleep += Tick_NowCounts() - Start;
+}
+
+/*
+ * Description:
+ * Charge the time since the last call to the previous state, then measure the given one.
+ */
+void Power_SetState(uint8 State)
+{
+	uint32 Now = Tick_NowCounts();
+	uint32 Elapsed = Now - g_Start;
+	uint32 Asleep = (g_Start_Asleep < Elapsed) ? g_Start_Asleep : Elapsed;
+
+	if (g_State < POWER_STATES_NUMBER)
+	{
+		g_Awake[g_State] += Elapsed - Asleep;
+		g_Asleep[g_State] += Asleep;
+
+		while ((g_Awake[g_State] + g_Asleep[g_State]) >= POWER_WINDOW_COUNTS)
+		{
+			g_Awake[g_State] >>= 1;
+			g_Asleep[g_State] >>= 1;
+		}
+	}
+
+	g_State = State;
+	g_Start = Now;
+	g_Start_Asleep = 0;
+}
+
+/*
+ * Description:
+ * Return the estimated average current of the controller in a state in uA, 0 if it was never measured.
+ */
+uint16 Power_GetCurrent(uint8 State)
+{
+	uint32 Total;
+	uint32 Awake_Permille;
+
+	if (State >= POWER_STATES_NUMBER)
+	{
+		return 0;
+	}
+
+	Total = g_Awake[State] + g_Asleep[State];
+	if (Total == 0)
+	{
+		return 0;
+	}
+
+	/* The sum stays below POWER_WINDOW_COUNTS, times 1000 fits in 32 bits */
+	Awake_Permille = (g_Awake[State] * 1000UL) / Total;
+
+	return (uint16)(POWER_IDLE_UA + (((POWER_ACTIVE_UA - POWER_IDLE_UA) * Awake_Permille) / 1000UL));
+}
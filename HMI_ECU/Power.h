@@ -0,0 +1,71 @@
+/*****************************************************************************************************************
+ * File Name: Power.h
+ * Date: 18/10/2026
+ * Driver: Idle Sleep and Current Draw Estimate Service Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The controller sleeps in Idle mode, the deepest one keeping the clock of Timer2 (the tick is synchronous,
+ * Power-save would stop it), the UART and the TWI running. Any interrupt wakes it up, the tick at least
+ * every msec. The ATmega32 has no pin change interrupt, the keypad is scanned on a timer. Only a profiling
+ * build with the Timer0 timestamp wakes it more often (every 256 usec), its estimates aren't the release ones.
+ *
+ * Typical supply current of the controller alone at 8 Mhz and 5 V (datasheet curves), in uA. The LCD, the
+ * motor and the buzzer are not counted. Measure them on the board and set them here for another supply.
+ */
+#ifndef POWER_ACTIVE_UA
+#define POWER_ACTIVE_UA                      12000UL
+#endif
+
+#ifndef POWER_IDLE_UA
+#define POWER_IDLE_UA                        5500UL
+#endif
+
+/* Application states measured separately (the sequence steps: 8 on Control ECU, 9 on HMI ECU) */
+#define POWER_STATES_NUMBER                  9
+
+/*
+ * The awake and asleep times of a state are halved once their sum reaches this many Tick counts (33 seconds
+ * at 8 Mhz), the estimate follows the recent behaviour and the products stay in 32 bits.
+ */
+#define POWER_WINDOW_COUNTS                  0x400000UL
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Select the Idle sleep mode and clear the measurements. Must be called after Tick_Init.
+ */
+void Power_Init(void);
+
+/*
+ * Description:
+ * Sleep until the next interrupt and measure the time asleep. Must be called with the interrupts disabled
+ * (after checking that there is nothing to do), returns with the interrupts enabled.
+ */
+void Power_Sleep(void);
+
+/*
+ * Description:
+ * Charge the time since the last call to the previous state, then measure the given one.
+ */
+void Power_SetState(uint8 State);
+
+/*
+ * Description:
+ * Return the estimated average current of the controller in a state in uA, 0 if it was never measured.
+ */
+uint16 Power_GetCurrent(uint8 State);
+
+#endif /* POWER_H_ */
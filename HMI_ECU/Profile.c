@@ -0,0 +1,204 @@
+/*****************************************************************************************************************
+ * File Name: Profile.c
+ * Date: 18/10/2026
+ * Driver: Function Profiling Service Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Profile.h"
+
+#ifdef PROFILE_ENABLE
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static Profile_EntryType g_Table[PROFILE_IDS_NUMBER];
+static uint32 g_Entry_Time[PROFILE_IDS_NUMBER];
+
+static uint32 (*g_Clock)(void) = NULL_PTR;
+static uint8 g_Cycles_Shift = 0;
+
+/* Nothing is recorded while the table is sent */
+static boolean g_Dumping = FALSE;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return the histogram bin of a duration: log2 of the cycles from PROFILE_HISTOGRAM_FIRST_BIT.
+ */
+static uint8 Profile_Bin(uint32 Cycles)
+{
+	uint8 Bit = 0;
+
+	while ((Cycles >> 1) != 0)
+	{
+		Cycles >>= 1;
+		Bit++;
+	}
+
+	if (Bit <= PROFILE_HISTOGRAM_FIRST_BIT)
+	{
+		return 0;
+	}
+
+	Bit -= PROFILE_HISTOGRAM_FIRST_BIT;
+
+	return (Bit >= PROFILE_HISTOGRAM_BINS) ? (PROFILE_HISTOGRAM_BINS - 1) : Bit;
+}
+
+/*
+ * Description:
+ * Send a number in decimal followed by a separator.
+ */
+static void Profile_SendNumber(void (*Send)(uint8 Byte), uint32 Number, uint8 Separator)
+{
+	uint8 Digits[10];
+	uint8 i = 0;
+
+	do
+	{
+		Digits[i++] = (uint8)('0' + (Number % 10));
+		Number /= 10;
+	} while (Number != 0);
+
+	while (i != 0)
+	{
+		Send(Digits[--i]);
+	}
+
+	Send(Separator);
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Clear the table and take the time from Clock, which returns counts of 2^Cycles_Shift CPU cycles
+ * (Timer0_GetTimestamp with shift 0, Tick_NowCounts with TICK_COUNT_CYCLES_SHIFT).
+ */
+void Profile_Init(uint32 (*Clock)(void), uint8 Cycles_Shift)
+{
+	uint8 Id;
+	uint8 Bin;
+
+	for (Id = 0; Id < PROFILE_IDS_NUMBER; Id++)
+	{
+		g_Table[Id].Count = 0;
+		g_Table[Id].Min = 0xFFFFFFFFUL;
+		g_Table[Id].Max = 0;
+		g_Table[Id].Sum = 0;
+
+		for (Bin = 0; Bin < PROFILE_HISTOGRAM_BINS; Bin++)
+		{
+			g_Table[Id].Histogram[Bin] = 0;
+		}
+	}
+
+	g_Cycles_Shift = Cycles_Shift;
+	g_Clock = Clock;
+}
+
+/*
+ * Description:
+ * Record the entry time of a profiled function.
+ */
+void Profile_Enter(Profile_IdType Id)
+{
+	if ((g_Clock != NULL_PTR) && !g_Dumping)
+	{
+		g_Entry_Time[Id] = g_Clock();
+	}
+}
+
+/*
+ * Description:
+ * Add the duration since the entry of a profiled function to its entry of the table.
+ */
+void Profile_Exit(Profile_IdType Id)
+{
+	Profile_EntryType *Entry = &g_Table[Id];
+	uint32 Cycles;
+	uint8 Bin;
+
+	if ((g_Clock == NULL_PTR) || g_Dumping)
+	{
+		return;
+	}
+
+	Cycles = (g_Clock() - g_Entry_Time[Id]) << g_Cycles_Shift;
+
+	/* The mean is kept over the first 65535 calls */
+	if (Entry -> Count != 0xFFFF)
+	{
+		Entry -> Count++;
+		Entry -> Sum += Cycles;
+	}
+	if (Cycles < Entry -> Min)
+	{
+		Entry -> Min = Cycles;
+	}
+	if (Cycles > Entry -> Max)
+	{
+		Entry -> Max = Cycles;
+	}
+
+	Bin = Profile_Bin(Cycles);
+	if (Entry -> Histogram[Bin] != 0xFFFF)
+	{
+		Entry -> Histogram[Bin]++;
+	}
+}
+
+/*
+ * Description:
+ * Return the entry of the table of a profiled function.
+ */
+const Profile_EntryType* Profile_GetEntry(Profile_IdType Id)
+{
+	return &g_Table[Id];
+}
+
+/*
+ * Description:
+ * Send the table as text lines through Send (UART_SendByte), one line per function called at least once:
+ * "id count min max mean : histogram bins", in CPU cycles. The functions called by Send are not recorded.
+ */
+void Profile_Dump(void (*Send)(uint8 Byte))
+{
+	const Profile_EntryType *Entry;
+	uint8 Id;
+	uint8 Bin;
+
+	g_Dumping = TRUE;
+
+	for (Id = 0; Id < PROFILE_IDS_NUMBER; Id++)
+	{
+		Entry = &g_Table[Id];
+		if (Entry -> Count == 0)
+		{
+			continue;
+		}
+
+		Profile_SendNumber(Send, Id, ' ');
+		Profile_SendNumber(Send, Entry -> Count, ' ');
+		Profile_SendNumber(Send, Entry -> Min, ' ');
+		Profile_SendNumber(Send, Entry -> Max, ' ');
+		Profile_SendNumber(Send, (uint32)(Entry -> Sum / Entry -> Count), ':');
+
+		Send(' ');
+		for (Bin = 0; Bin < PROFILE_HISTOGRAM_BINS; Bin++)
+		{
+			Profile_SendNumber(Send, Entry -> Histogram[Bin], (Bin == (PROFILE_HISTOGRAM_BINS - 1)) ? '\r' : ' ');
+		}
+		Send('\n');
+	}
+
+	g_Dumping = FALSE;
+}
+
+#endif /* PROFILE_ENABLE */
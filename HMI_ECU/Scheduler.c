@@ -0,0 +1,267 @@
+/*****************************************************************************************************************
+ * File Name: Scheduler.c
+ * Date: 18/10/2026
+ * Driver: Cooperative Run-To-Completion Event Scheduler Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "Tick.h"
+#include "Power.h"
+#include "Watchdog.h"
+#include "Scheduler.h"
+
+#define SCHEDULER_QUEUE_MASK                 (SCHEDULER_QUEUE_SIZE - 1)
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static Scheduler_EventType g_Queue[SCHEDULER_QUEUE_SIZE];
+static volatile uint8 g_Head = 0;    /* next event to hand to the tasks */
+static volatile uint8 g_Count = 0;
+static volatile uint8 g_LostEvents = 0;
+
+static Scheduler_TaskType g_Tasks[SCHEDULER_MAX_TASKS];
+static uint8 g_TasksNumber = 0;
+
+/* Latency monitor */
+static Scheduler_StatisticsType g_Statistics;
+static const uint16 *g_Budgets = NULL_PTR;
+static uint8 g_BudgetsNumber = 0;
+static uint8 g_State = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Take the oldest event out of the queue, returns FALSE if the queue is empty.
+ */
+static boolean Scheduler_Take(Scheduler_EventType *Event)
+{
+	boolean Taken = FALSE;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (g_Count != 0)
+		{
+			*Event = g_Queue[g_Head];
+			g_Head = (g_Head + 1) & SCHEDULER_QUEUE_MASK;
+			g_Count--;
+			Taken = TRUE;
+		}
+	}
+
+	return Taken;
+}
+
+/*
+ * Description:
+ * Count an event late if it waited more than SCHEDULER_LATENCY_BUDGET_MS, keep the longest wait.
+ */
+static void Scheduler_CheckLatency(uint32 Latency)
+{
+	if (Latency > g_Statistics.Max_Latency)
+	{
+		g_Statistics.Max_Latency = Latency;
+	}
+
+	if ((Latency > (SCHEDULER_LATENCY_BUDGET_MS * TICK_COUNTS_PER_MS)) && (g_Statistics.Late_Events != 0xFFFF))
+	{
+		g_Statistics.Late_Events++;
+	}
+}
+
+/*
+ * Description:
+ * Count an overrun if the tasks ran longer than the budget of the state, keep the longest run and overrun.
+ */
+static void Scheduler_CheckRun(uint8 State, uint8 Type, uint32 Run)
+{
+	uint32 Budget = (State < g_BudgetsNumber) ? g_Budgets[State] : SCHEDULER_DEFAULT_BUDGET_MS;
+
+	if (Run > g_Statistics.Max_Run)
+	{
+		g_Statistics.Max_Run = Run;
+	}
+
+	if (Run <= (Budget * TICK_COUNTS_PER_MS))
+	{
+		return;
+	}
+
+	if (g_Statistics.Overruns != 0xFFFF)
+	{
+		g_Statistics.Overruns++;
+	}
+
+	if (Run > g_Statistics.Overrun_Time)
+	{
+		g_Statistics.Overrun_State = State;
+		g_Statistics.Overrun_Event = Type;
+		g_Statistics.Overrun_Time = Run;
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Empty the event queue and the task list.
+ */
+void Scheduler_Init(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_Head = 0;
+		g_Count = 0;
+		g_LostEvents = 0;
+	}
+
+	g_TasksNumber = 0;
+
+	g_Statistics.Max_Run = 0;
+	g_Statistics.Max_Latency = 0;
+	g_Statistics.Late_Events = 0;
+	g_Statistics.Overruns = 0;
+	g_Statistics.Overrun_State = 0;
+	g_Statistics.Overrun_Event = 0;
+	g_Statistics.Overrun_Time = 0;
+	g_Budgets = NULL_PTR;
+	g_BudgetsNumber = 0;
+	g_State = 0;
+}
+
+/*
+ * Description:
+ * Add a task receiving every event, the tasks are called in the order they were added.
+ * Returns FALSE if SCHEDULER_MAX_TASKS tasks are already added.
+ */
+boolean Scheduler_AddTask(Scheduler_TaskType Task)
+{
+	if (g_TasksNumber >= SCHEDULER_MAX_TASKS)
+	{
+		return FALSE;
+	}
+
+	g_Tasks[g_TasksNumber] = Task;
+	g_TasksNumber++;
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Queue an event, from a task or an interrupt. Returns FALSE (and counts the loss) if the queue is full.
+ */
+boolean Scheduler_Post(uint8 Type, uint8 Data)
+{
+	uint32 Posted = Tick_NowCounts();
+	boolean Result = TRUE;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (g_Count >= SCHEDULER_QUEUE_SIZE)
+		{
+			if (g_LostEvents != 0xFF)
+			{
+				g_LostEvents++;
+			}
+			Result = FALSE;
+		}
+		else
+		{
+			g_Queue[(g_Head + g_Count) & SCHEDULER_QUEUE_MASK].Type = Type;
+			g_Queue[(g_Head + g_Count) & SCHEDULER_QUEUE_MASK].Data = Data;
+			g_Queue[(g_Head + g_Count) & SCHEDULER_QUEUE_MASK].Posted = Posted;
+			g_Count++;
+		}
+	}
+
+	return Result;
+}
+
+/*
+ * Description:
+ * Return the number of events lost because the queue was full (saturated at 0xFF).
+ */
+uint8 Scheduler_GetLostEvents(void)
+{
+	return g_LostEvents;
+}
+
+/*
+ * Description:
+ * Set the run budget in msec of every application state (States_Number entries, kept by reference).
+ */
+void Scheduler_SetBudgets(const uint16 *Budgets_Ms, uint8 States_Number)
+{
+	g_Budgets = Budgets_Ms;
+	g_BudgetsNumber = States_Number;
+}
+
+/*
+ * Description:
+ * Tell the state reached after an event: the next events are checked against its budget and the time until
+ * the next event is charged to it (Power_SetState).
+ */
+void Scheduler_SetState(uint8 State)
+{
+	g_State = State;
+	Power_SetState(State);
+}
+
+/*
+ * Description:
+ * Return the latency monitor statistics since Scheduler_Init.
+ */
+const Scheduler_StatisticsType* Scheduler_GetStatistics(void)
+{
+	return &g_Statistics;
+}
+
+/*
+ * Description:
+ * Hand the queued events to the tasks forever. When there is none, sleep until the next interrupt.
+ * Every iteration checks in with the watchdog. The I-bit must be set.
+ */
+void Scheduler_Run(void)
+{
+	Scheduler_EventType Event;
+	uint32 Start;
+	uint8 State;
+	uint8 i;
+
+	while (1)
+	{
+		/* A task stuck longer than the watchdog period resets the controller, recorded with its state */
+		Watchdog_Checkpoint(g_State);
+
+		if (Scheduler_Take(&Event))
+		{
+			Start = Tick_NowCounts();
+			State = g_State;
+			Scheduler_CheckLatency(Start - Event.Posted);
+
+			for (i = 0; i < g_TasksNumber; i++)
+			{
+				g_Tasks[i](&Event);
+			}
+
+			Scheduler_CheckRun(State, Event.Type, Tick_NowCounts() - Start);
+			continue;
+		}
+
+		/* An event posted after the check would wait for the next interrupt, check again interrupts disabled */
+		cli();
+		if (g_Count == 0)
+		{
+			Power_Sleep();
+		}
+		sei();
+	}
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************************************************
+ * File Name: Scheduler.h
+ * Date: 18/10/2026
+ * Driver: Cooperative Run-To-Completion Event Scheduler Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The interrupts (timer wheel call backs, UART reception...) post events into one queue, the main loop hands
+ * them one by one to every task. A task handles an event and returns (run to completion), it never waits for
+ * something that another event brings, so every task keeps answering while a long activity is running.
+ * With no event left the controller sleeps (Power_Sleep) until an interrupt, Power_Init must be called first.
+ */
+#define SCHEDULER_QUEUE_SIZE                 16    /* power of two */
+#define SCHEDULER_MAX_TASKS                  4
+
+#if ((SCHEDULER_QUEUE_SIZE & (SCHEDULER_QUEUE_SIZE - 1)) != 0) || (SCHEDULER_QUEUE_SIZE > 128)
+
+#error "The scheduler queue size should be a power of two up to 128"
+
+#endif
+
+/*
+ * Latency monitor: an event waiting more than SCHEDULER_LATENCY_BUDGET_MS in the queue is late (a timer event
+ * is posted at its deadline), and the tasks of one event running longer than the budget of the application
+ * state (Scheduler_SetBudgets, SCHEDULER_DEFAULT_BUDGET_MS otherwise) overrun it.
+ */
+#ifndef SCHEDULER_LATENCY_BUDGET_MS
+#define SCHEDULER_LATENCY_BUDGET_MS          50
+#endif
+
+#ifndef SCHEDULER_DEFAULT_BUDGET_MS
+#define SCHEDULER_DEFAULT_BUDGET_MS          100
+#endif
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* The event types are defined by the application */
+typedef struct
+{
+	uint8 Type;
+	uint8 Data;
+	uint32 Posted;             /* Tick_NowCounts when posted */
+}Scheduler_EventType;
+
+typedef void (*Scheduler_TaskType)(const Scheduler_EventType *Event);
+
+/* The times are in Tick counts (TICK_COUNTS_PER_MS per msec), the counters saturate at 0xFFFF */
+typedef struct
+{
+	uint32 Max_Run;            /* longest run of the tasks for one event: the worst gap between two iterations */
+	uint32 Max_Latency;        /* longest wait of an event in the queue */
+	uint16 Late_Events;        /* events that waited more than SCHEDULER_LATENCY_BUDGET_MS */
+	uint16 Overruns;           /* events whose tasks ran longer than the budget of the state */
+	uint8 Overrun_State;       /* state and event of the longest overrun */
+	uint8 Overrun_Event;
+	uint32 Overrun_Time;
+}Scheduler_StatisticsType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Empty the event queue and the task list.
+ */
+void Scheduler_Init(void);
+
+/*
+ * Description:
+ * Add a task receiving every event, the tasks are called in the order they were added.
+ * Returns FALSE if SCHEDULER_MAX_TASKS tasks are already added.
+ */
+boolean Scheduler_AddTask(Scheduler_TaskType Task);
+
+/*
+ * Description:
+ * Queue an event, from a task or an interrupt. Returns FALSE (and counts the loss) if the queue is full.
+ */
+boolean Scheduler_Post(uint8 Type, uint8 Data);
+
+/*
+ * Description:
+ * Return the number of events lost because the queue was full (saturated at 0xFF).
+ */
+uint8 Scheduler_GetLostEvents(void);
+
+/*
+ * Description:
+ * Set the run budget in msec of every application state (States_Number entries, kept by reference).
+ */
+void Scheduler_SetBudgets(const uint16 *Budgets_Ms, uint8 States_Number);
+
+/*
+ * Description:
+ * Tell the state reached after an event: the next events are checked against its budget and the time until
+ * the next event is charged to it (Power_SetState).
+ */
+void Scheduler_SetState(uint8 State);
+
+/*
+ * Description:
+ * Return the latency monitor statistics since Scheduler_Init.
+ */
+const Scheduler_StatisticsType* Scheduler_GetStatistics(void);
+
+/*
+ * Description:
+ * Hand the queued events to the tasks forever. When there is none, sleep until the next interrupt.
+ * Every iteration checks in with the watchdog. The I-bit must be set.
+ */
+void Scheduler_Run(void);
+
+#endif /* SCHEDULER_H_ */
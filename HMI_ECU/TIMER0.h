@@ -0,0 +1,160 @@
+/*******************************************************************************************************************
+ * File Name: TIMER0.h
+ * Date: 16/7/2023
+ * Driver: ATmega32 Timer0 Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+#include "Common_Macros.h"
+
+#ifndef TIMER0_H_
+#define TIMER0_H_
+
+/****************************************************************************************
+ *                                      Macros Definitions                              *
+ ****************************************************************************************/
+
+/*
+ * Timer0_GetTimestamp counts CPU cycles, it wraps after 2^32 cycles (537 seconds at 8 Mhz).
+ * With F_CPU/8 one count is 1 usec at 8 Mhz and the overflow interrupt comes every 256 usec, so the PWM modes
+ * count the overflows only after Timer0_StartTimestamp (the profiling build), the interrupt would wake the
+ * sleeping CPU four times every tick.
+ */
+#define TIMER0_CYCLES_TO_US(CYCLES)          ((CYCLES) / (F_CPU / 1000000UL))
+
+/*
+ * Configuration from a duration, computed at compile time from F_CPU: a CTC period of PERIOD_US usec takes
+ * the smallest pre-scaler (the finest resolution) whose counts fit in the 8-bit compare register, the counts
+ * are rounded to the nearest one. A period shorter than one count or longer than 256 counts at F_CPU/1024
+ * stops the build, like a DIVIDER that isn't one of the pre-scalers.
+ *     Timer0_ConfigType Config = TIMER0_CTC_CONFIG_MS(10);
+ */
+#define TIMER0_COUNTS(PERIOD_US,DIVIDER)    ((((F_CPU / 1000ULL) * (PERIOD_US) / (DIVIDER)) + 500ULL) / 1000ULL)
+
+#define TIMER0_FITS(PERIOD_US,DIVIDER)      ((TIMER0_COUNTS(PERIOD_US,DIVIDER) >= 1ULL) && \
+                                             (TIMER0_COUNTS(PERIOD_US,DIVIDER) <= 256ULL))
+
+#define TIMER0_IS_DIVIDER(DIVIDER) \
+	(((DIVIDER) == 1) || ((DIVIDER) == 8) || ((DIVIDER) == 64) || ((DIVIDER) == 256) || \
+	((DIVIDER) == 1024))
+
+/* Smallest pre-scaler division reaching the period */
+#define TIMER0_DIVIDER(PERIOD_US) \
+	((TIMER0_COUNTS(PERIOD_US,1ULL) <= 256ULL) ? 1ULL : \
+	(TIMER0_COUNTS(PERIOD_US,8ULL) <= 256ULL) ? 8ULL : \
+	(TIMER0_COUNTS(PERIOD_US,64ULL) <= 256ULL) ? 64ULL : \
+	(TIMER0_COUNTS(PERIOD_US,256ULL) <= 256ULL) ? 256ULL : \
+	1024ULL)
+
+/* Clock select of a pre-scaler division */
+#define TIMER0_PRESCALER(DIVIDER) \
+	((((DIVIDER) == 1) ? TIMER0_Prescaler_1 : ((DIVIDER) == 8) ? TIMER0_Prescaler_8 : \
+	((DIVIDER) == 64) ? TIMER0_Prescaler_64 : ((DIVIDER) == 256) ? TIMER0_Prescaler_256 : \
+	((DIVIDER) == 1024) ? TIMER0_Prescaler_1024 : \
+	TIMER0_No_Clock) + \
+	STATIC_CHECK(TIMER0_IS_DIVIDER(DIVIDER)))
+
+/* Compare value (TOP) of a period at a pre-scaler division */
+#define TIMER0_COMPARE(PERIOD_US,DIVIDER) \
+	((uint8)(TIMER0_COUNTS(PERIOD_US,DIVIDER) - 1ULL) + STATIC_CHECK(TIMER0_FITS(PERIOD_US,DIVIDER)))
+
+#define TIMER0_CTC_CONFIG_US(PERIOD_US) \
+	{0, TIMER0_COMPARE(PERIOD_US,TIMER0_DIVIDER(PERIOD_US)), TIMER0_PRESCALER(TIMER0_DIVIDER(PERIOD_US)), TIMER0_CTC_2}
+
+#define TIMER0_CTC_CONFIG_MS(PERIOD_MS)     TIMER0_CTC_CONFIG_US((PERIOD_MS) * 1000ULL)
+
+/****************************************************************************************
+ *                                      Types Declaration                               *
+ ****************************************************************************************/
+
+typedef enum
+{
+	TIMER0_No_Clock,
+	TIMER0_Prescaler_1,
+	TIMER0_Prescaler_8,
+	TIMER0_Prescaler_64,
+	TIMER0_Prescaler_256,
+	TIMER0_Prescaler_1024,
+	TIMER0_External_Clock_Falling_Edge,
+	TIMER0_External_Clock_Rising_Edge
+}Timer0_Clock_Select;
+
+typedef enum
+{
+	TIMER0_Normal_0,
+	TIMER0_PhaseCorrect_PWM_1,
+	TIMER0_CTC_2,
+	TIMER0_Fast_PWM_3
+}WaveFormGenerationMode;
+
+typedef struct
+{
+	uint8 Initial_Value;
+	uint8 Compare_Value;
+	Timer0_Clock_Select Prescalar;
+	WaveFormGenerationMode Timer_Mode;
+}Timer0_ConfigType;
+
+/****************************************************************************************
+ *                                      Functions Prototypes                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Initialization of Timer0 (Enable Timer0)
+ * 1. Let the TCNT0 Register = The Start value of the timer.
+ * 2. Enable FOC0 bit in the TCCR0 Register.
+ * 3. Enable CS02:0 bits according to the required pre-scalar
+ * 4. Configure the TCCR0 Register according to the Timer0 Mode.
+ * 5. Configure the TIMSK Register (Interrupt Mask) according to Timer0 Mode.
+ * 6. In CTC Mode Let OCR0 = the compare value (TOP Value)
+ */
+void Timer0_NonPWM_Mode_Init(const Timer0_ConfigType* Config_Ptr);
+
+/*
+ * Description:
+ * The function responsible for trigger the Timer0 with the PWM Mode.
+ * 1. Let the TCNT0 Register = The Start value of the timer.
+ * 2. Disable FOC0 bit in the TCCR0 Register (FOC0 = 0)
+ * 3. Enable CS02:0 bits according to the required pre-scalar.
+ * 4. Setup the direction for OC0 as output pin through the GPIO driver.
+ * 5. Configuration the PWM Mode (Phase Correct or Fast)
+ * 6. Setup the PWM mode with Non-Inverting.
+ */
+void Timer0_PWM_Mode_Init(const Timer0_ConfigType* Config_Ptr);
+
+/*
+ * Description:
+ * The Speed is passed to this function to calculate the duty cycle and hence get the OCR0 Value.
+ */
+void TIMER0_PWM_Start(uint8 Duty_Cycle);
+
+/*
+ * Description:
+ * De-initialization of Timer0 (Disable)
+ */
+void Timer0_DeInit(void);
+
+/*
+ * Description:
+ * Return the CPU cycles counted by Timer0 (overflows, TCNT0 and pre-scalar) with the resolution of one count.
+ * Valid in Normal Mode, and in Fast PWM Mode after Timer0_StartTimestamp. Subtract two readings taken while
+ * Timer0 runs to get a duration.
+ */
+uint32 Timer0_GetTimestamp(void);
+
+/*
+ * Description:
+ * Count the overflows of Timer0 in PWM Modes for Timer0_GetTimestamp (its interrupt every 256 counts), until
+ * Timer0_DeInit. Must be called after Timer0_PWM_Mode_Init.
+ */
+void Timer0_StartTimestamp(void);
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void Timer0_SetCallBack(void(*a_ptr)(void));
+
+
+#endif /* TIMER0_H_ */
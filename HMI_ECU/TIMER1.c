@@ -9,6 +9,19 @@
 #include "GPIO.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
+
+/* Output compare pins of Timer1 */
+#define TIMER1_OC1A_PORT_ID                 PORTD_ID
+#define TIMER1_OC1A_PIN_ID                  PIN5_ID
+#define TIMER1_OC1B_PORT_ID                 PORTD_ID
+#define TIMER1_OC1B_PIN_ID                  PIN4_ID
+
+/* Input capture pin of Timer1 */
+#define TIMER1_ICP1_PORT_ID                 PORTD_ID
+#define TIMER1_ICP1_PIN_ID                  PIN6_ID
+
+#define TIMER1_CAPTURE_BUFFER_MASK          (TIMER1_CAPTURE_BUFFER_SIZE - 1)
 
 /***************************************************************************************
  *                                         Global Variables                            *
@@ -16,18 +29,105 @@
 /* Global variables to hold the address of the call back function in the application */
 static volatile void (*g_callBackPtr)(void) = NULL_PTR;
 
+/* Frequency PWM: TOP of the last frequency and duty cycles, the new TOP waits for the overflow interrupt */
+static boolean g_PwmRunning = FALSE;
+static uint16 g_PwmTop = 0;
+static uint16 g_PwmDuty[2] = {0, 0};
+static volatile boolean g_PwmPending = FALSE;
+static volatile uint16 g_PendingTop = 0;
+static volatile uint8 g_PendingClock = TIMER1_No_Clock;
+
+/* Input capture: ring of captures and overflows of the free-running count */
+static Timer1_CaptureType g_Captures[TIMER1_CAPTURE_BUFFER_SIZE];
+static volatile uint8 g_CaptureHead = 0;    /* next capture to read */
+static volatile uint8 g_CaptureCount = 0;
+static volatile uint8 g_LostCaptures = 0;
+static volatile uint16 g_CaptureOverflows = 0;
+static volatile boolean g_CaptureRunning = FALSE;
+static boolean g_CaptureBothEdges = FALSE;
+static void (*volatile g_CaptureCallBackPtr)(void) = NULL_PTR;
+
+/* Pre-scaler of every clock select as a power of two */
+static const uint8 g_PrescalerShifts[TIMER1_Prescaler_1024 + 1] = {0, 0, 3, 6, 8, 10};
+
 /*******************************************************************************
  *                       Interrupt Service Routines                            *
  *******************************************************************************/
-/* Interrupt for Normal (Overflow) Mode */
+/* Interrupt for Normal (Overflow) Mode, and of the frequency PWM after TOP */
 ISR(TIMER1_OVF_vect)
 {
+	if (g_PwmPending)
+	{
+		/*
+		 * The counter has just restarted from BOTTOM and the double buffered OCR1x took the compares of the new
+		 * period at TOP, ICR1 isn't buffered so it is written now. A TOP already passed would let the counter run
+		 * to 0xFFFF, restart the period instead.
+		 */
+		ICR1 = g_PendingTop;
+		TCCR1B = (TCCR1B & 0xF8) | g_PendingClock;
+		if (TCNT1 >= g_PendingTop)
+		{
+			TCNT1 = 0;
+		}
+		g_PwmPending = FALSE;
+		CLEAR_BIT(TIMSK, TOIE1);
+		return;
+	}
+
+	/* Upper half of the capture timestamps */
+	if (g_CaptureRunning)
+	{
+		g_CaptureOverflows++;
+	}
+
 	if(g_callBackPtr != NULL_PTR)
 	{
 		/* Call the Call Back function in the application after the edge is detected */
 		(*g_callBackPtr)();
 	}
 }
+/* Interrupt of the input capture */
+ISR(TIMER1_CAPT_vect)
+{
+	uint16 Count = ICR1;
+	uint16 Overflows = g_CaptureOverflows;
+	uint8 Level = BIT_IS_SET(TCCR1B, ICES1) ? LOGIC_HIGH : LOGIC_LOW;
+	uint8 Index;
+
+	/* An overflow whose interrupt is still waiting came before the capture if the captured count is low */
+	if (BIT_IS_SET(TIFR, TOV1) && (Count < 0x8000))
+	{
+		Overflows++;
+	}
+
+	if (g_CaptureBothEdges)
+	{
+		/* Catch the opposite edge next, its flag must be cleared after the edge is switched */
+		TOGGLE_BIT(TCCR1B, ICES1);
+		TIFR = (1<<ICF1);
+	}
+
+	if (g_CaptureCount >= TIMER1_CAPTURE_BUFFER_SIZE)
+	{
+		if (g_LostCaptures != 0xFF)
+		{
+			g_LostCaptures++;
+		}
+		return;
+	}
+
+	Index = (g_CaptureHead + g_CaptureCount) & TIMER1_CAPTURE_BUFFER_MASK;
+	g_Captures[Index].Timestamp = ((uint32)Overflows << 16) | Count;
+	g_Captures[Index].Level = Level;
+	g_CaptureCount++;
+
+	/* One notification per burst, the application reads until the ring is empty */
+	if ((g_CaptureCount == 1) && (g_CaptureCallBackPtr != NULL_PTR))
+	{
+		(*g_CaptureCallBackPtr)();
+	}
+}
+
 /* Interrupt for Compare Mode */
 ISR(TIMER1_COMPA_vect)
 {
@@ -51,11 +151,13 @@ ISR(TIMER1_COMPA_vect)
  * 4. Configure the TCCR1B Register according to the Timer1 Mode.
  * 5. In CTC Mode Let OCR1A = the compare value (TOP Value).
  * 6. Set the OCIE1A in TIMSK Register to enable the interrupt of timer1 mode A.
+ * 7. Clear TOV1, Timer1_HasOverflowed tells the overflows of this count only.
  */
 void Timer1_NonPWm_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 {
 
 	TCNT1 = Config_Ptr -> initial_value;
+	TIFR = (1<<TOV1);
 	TCCR1A = (1<<FOC1A) | (1<<FOC1B) ;
 
 	/* Set to required pre-scalar Configuration*/
@@ -78,8 +180,8 @@ void Timer1_NonPWm_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 		TCCR1B = (TCCR1B & 0xF7) | (1 << WGM12);
 	}
 
-	/* Enable Timer1 Interrupt for mode A */
-	TIMSK = (1<<OCIE1A);
+	/* Enable Timer1 Interrupt for mode A, the bits of Timer0 and Timer2 are kept */
+	TIMSK = (TIMSK & 0xC3) | (1<<OCIE1A);
 }
 
 /*
@@ -103,7 +205,7 @@ void Timer1_PWM_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 	TCCR1B = (TCCR1B & 0xF8) | (Config_Ptr -> prescaler);
 
 	/* Configure the OC1A pin as Output Pin */
-	GPIO_SetupPinDirection(PORTD_ID, PIN4_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(TIMER1_OC1A_PORT_ID, TIMER1_OC1A_PIN_ID, OUTPUT_PIN);
 
 	/* Preparing TCCR1A & TCCR1B Registers to configuration according to required Mode */
 	TCCR1A &= 0x3C;      /* TCCR1A & 0011 1100 */
@@ -225,24 +327,231 @@ void Timer1_PWM_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 
 /*
  * Description:
- * Function to
- * 1. calculate the OCR1A Value from required Duty Cycle.
- * 2. Put Compare and TOP values of (ICR1 or OCR1A) registers.
+ * Run Timer1 as a PWM of the given frequency in Hz (1 - TIMER1_PWM_MAX_FREQUENCY), the duty cycles of both
+ * channels are kept. Started from a stopped timer both outputs stay low until Timer1_PWM_SetDuty. While the PWM
+ * runs the new period starts after the next TOP, no period is cut. Returns FALSE if the frequency is out of reach.
  */
-void TIMER1_PWM_Start (uint16 Duty_Cycle)
+boolean Timer1_PWM_SetFrequency(uint32 Frequency)
 {
-	ICR1 = 2499;
-	OCR1A = Duty_Cycle;
+	uint32 Counts = 0;
+	uint8 Clock;
+
+	if ((Frequency == 0) || (Frequency > TIMER1_PWM_MAX_FREQUENCY))
+	{
+		return FALSE;
+	}
+
+	/* The smallest pre-scaler whose period fits in 16 bits */
+	for (Clock = TIMER1_Prescaler_1; Clock <= TIMER1_Prescaler_1024; Clock++)
+	{
+		Counts = (F_CPU >> g_PrescalerShifts[Clock]) / Frequency;
+		if (Counts <= 0x10000UL)
+		{
+			break;
+		}
+	}
+
+	if ((Clock > TIMER1_Prescaler_1024) || (Counts < TIMER1_PWM_MIN_COUNTS))
+	{
+		return FALSE;
+	}
+
+	g_PwmTop = (uint16)(Counts - 1);
+
+	if (!g_PwmRunning)
+	{
+		/* Stopped in Normal Mode the compares are written directly, in a PWM Mode only the buffers are */
+		TCCR1B = 0;
+		TCCR1A = 0;
+		TCNT1 = 0;
+
+		/* ICR1 becomes TOP, no capture any more */
+		g_CaptureRunning = FALSE;
+		TIMSK &= 0xC3;
+		ICR1 = g_PwmTop;
+		Timer1_PWM_SetDuty(TIMER1_Channel_A, g_PwmDuty[TIMER1_Channel_A]);
+		Timer1_PWM_SetDuty(TIMER1_Channel_B, g_PwmDuty[TIMER1_Channel_B]);
+
+		GPIO_WritePin(TIMER1_OC1A_PORT_ID, TIMER1_OC1A_PIN_ID, LOGIC_LOW);
+		GPIO_WritePin(TIMER1_OC1B_PORT_ID, TIMER1_OC1B_PIN_ID, LOGIC_LOW);
+		GPIO_SetupPinDirection(TIMER1_OC1A_PORT_ID, TIMER1_OC1A_PIN_ID, OUTPUT_PIN);
+		GPIO_SetupPinDirection(TIMER1_OC1B_PORT_ID, TIMER1_OC1B_PIN_ID, OUTPUT_PIN);
+
+		/* Fast PWM with ICR1 as TOP: WGM13:0 = 1110, the outputs are connected by Timer1_PWM_SetDuty */
+		TCCR1A |= (1<<WGM11);
+		TCCR1B = (1<<WGM13) | (1<<WGM12) | Clock;
+		g_PwmRunning = TRUE;
+		return TRUE;
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		/* The buffered compares of the new period, ICR1 and the pre-scaler follow in the overflow interrupt */
+		Timer1_PWM_SetDuty(TIMER1_Channel_A, g_PwmDuty[TIMER1_Channel_A]);
+		Timer1_PWM_SetDuty(TIMER1_Channel_B, g_PwmDuty[TIMER1_Channel_B]);
+		g_PendingTop = g_PwmTop;
+		g_PendingClock = Clock;
+		g_PwmPending = TRUE;
+
+		/* Clear an overflow flag left from an earlier period, the interrupt must come from the next TOP */
+		TIFR = (1<<TOV1);
+		SET_BIT(TIMSK, TOIE1);
+	}
+
+	return TRUE;
 }
+
 /*
  * Description:
- * Function to disable the Timer1.
+ * Set the duty cycle of a channel in per-mille (0 - TIMER1_PWM_DUTY_FULL), it starts after the next TOP (OCR1x
+ * are double buffered). 0 disconnects the pin at once (low), a compare of 0 would still give a short pulse.
+ */
+void Timer1_PWM_SetDuty(Timer1_Channel Channel, uint16 Duty_PerMille)
+{
+	uint16 Compare;
+
+	if (Duty_PerMille > TIMER1_PWM_DUTY_FULL)
+	{
+		Duty_PerMille = TIMER1_PWM_DUTY_FULL;
+	}
+	g_PwmDuty[Channel] = Duty_PerMille;
+
+	/* A compare equal to TOP keeps the output high for the whole period */
+	Compare = (uint16)((((uint32)g_PwmTop * Duty_PerMille) + (TIMER1_PWM_DUTY_FULL / 2)) / TIMER1_PWM_DUTY_FULL);
+
+	if (Channel == TIMER1_Channel_A)
+	{
+		OCR1A = Compare;
+		TCCR1A = (Duty_PerMille == 0) ? (TCCR1A & ~(1<<COM1A1)) : (TCCR1A | (1<<COM1A1));
+	}
+	else
+	{
+		OCR1B = Compare;
+		TCCR1A = (Duty_PerMille == 0) ? (TCCR1A & ~(1<<COM1B1)) : (TCCR1A | (1<<COM1B1));
+	}
+}
+
+/*
+ * Description:
+ * Start timestamping the edges on ICP1: Timer1 counts from zero in Normal Mode at the pre-scaler, the captures
+ * queue in a ring of TIMER1_CAPTURE_BUFFER_SIZE filled by the capture interrupt. The I-bit must be set.
+ */
+void Timer1_Capture_Init(const Timer1_CaptureConfigType * Config_Ptr)
+{
+	/* Stop the timer and disconnect the outputs before the new mode */
+	TCCR1B = 0;
+	TCCR1A = 0;
+	TCNT1 = 0;
+	g_PwmRunning = FALSE;
+	g_PwmPending = FALSE;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_CaptureHead = 0;
+		g_CaptureCount = 0;
+		g_LostCaptures = 0;
+		g_CaptureOverflows = 0;
+	}
+	g_CaptureBothEdges = (Config_Ptr -> edge == TIMER1_Capture_Both_Edges) ? TRUE : FALSE;
+
+	GPIO_SetupPinDirection(TIMER1_ICP1_PORT_ID, TIMER1_ICP1_PIN_ID, INPUT_PIN);
+
+	if (Config_Ptr -> noise_canceler)
+	{
+		SET_BIT(TCCR1B, ICNC1);
+	}
+
+	/* With both edges the first one is the opposite of the present level */
+	if ((Config_Ptr -> edge == TIMER1_Capture_Rising_Edge) || ((Config_Ptr -> edge == TIMER1_Capture_Both_Edges) &&
+			(GPIO_ReadPin(TIMER1_ICP1_PORT_ID, TIMER1_ICP1_PIN_ID) == LOGIC_LOW)))
+	{
+		SET_BIT(TCCR1B, ICES1);
+	}
+
+	/* Drop the flags of the edges before now, enable the capture and overflow interrupts only */
+	TIFR = (1<<ICF1) | (1<<TOV1);
+	TIMSK = (TIMSK & 0xC3) | (1<<TICIE1) | (1<<TOIE1);
+	g_CaptureRunning = TRUE;
+
+	/* Start counting, WGM13:0 = 0000 (Normal Mode) */
+	TCCR1B = (TCCR1B & 0xF8) | (Config_Ptr -> prescaler);
+}
+
+/*
+ * Description:
+ * Take the oldest capture out of the ring, returns FALSE if there is none.
+ */
+boolean Timer1_Capture_Read(Timer1_CaptureType * Capture_Ptr)
+{
+	boolean Read = FALSE;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (g_CaptureCount != 0)
+		{
+			*Capture_Ptr = g_Captures[g_CaptureHead];
+			g_CaptureHead = (g_CaptureHead + 1) & TIMER1_CAPTURE_BUFFER_MASK;
+			g_CaptureCount--;
+			Read = TRUE;
+		}
+	}
+
+	return Read;
+}
+
+/*
+ * Description:
+ * Return the number of captures lost because the ring was full (saturated at 0xFF).
+ */
+uint8 Timer1_Capture_GetLostCaptures(void)
+{
+	return g_LostCaptures;
+}
+
+/*
+ * Description:
+ * Set the function called from the capture interrupt when a capture enters the empty ring, the application
+ * reads until Timer1_Capture_Read returns FALSE.
+ */
+void Timer1_Capture_SetCallBack(void(*a_ptr)(void))
+{
+	g_CaptureCallBackPtr = a_ptr;
+}
+
+/*
+ * Description:
+ * Function to disable the Timer1 (the PWM outputs and the captures too).
  */
 void Timer1_DeInit(void)
 {
 	TCCR1A = 0;
 	TCCR1B = 0;
-	TIMSK = 0;
+	TIMSK &= 0xC3;       /* TIMSK & 1100 0011, clear TICIE1, OCIE1A, OCIE1B and TOIE1 only */
+
+	g_PwmRunning = FALSE;
+	g_PwmPending = FALSE;
+	g_CaptureRunning = FALSE;
+	g_PwmDuty[TIMER1_Channel_A] = 0;
+	g_PwmDuty[TIMER1_Channel_B] = 0;
+}
+
+/*
+ * Description:
+ * Function to read the current count of Timer1 (TCNT1).
+ */
+uint16 Timer1_GetCount(void)
+{
+	return TCNT1;
+}
+
+/*
+ * Description:
+ * Function to tell whether the count overflowed since Timer1_NonPWm_Mode_Init in Normal Mode (TOV1, the
+ * overflow interrupt is off in this mode so the flag stays set).
+ */
+boolean Timer1_HasOverflowed(void)
+{
+	return BIT_IS_SET(TIFR, TOV1) ? TRUE : FALSE;
 }
 
 /*
@@ -0,0 +1,131 @@
+/*******************************************************************************************************************
+ * File Name: TIMER2.h
+ * Date: 18/10/2026
+ * Driver: ATmega32 Timer2 Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+#include "Common_Macros.h"
+
+#ifndef TIMER2_H_
+#define TIMER2_H_
+
+/****************************************************************************************
+ *                                      Macros Definitions                              *
+ ****************************************************************************************/
+
+/*
+ * Configuration from a duration, computed at compile time from F_CPU: a CTC period of PERIOD_US usec takes
+ * the smallest pre-scaler (the finest resolution) whose counts fit in the 8-bit compare register, the counts
+ * are rounded to the nearest one. A period shorter than one count or longer than 256 counts at F_CPU/1024
+ * stops the build, like a DIVIDER that isn't one of the pre-scalers.
+ *     Timer2_ConfigType Config = TIMER2_CTC_CONFIG_MS(10);
+ */
+#define TIMER2_COUNTS(PERIOD_US,DIVIDER)    ((((F_CPU / 1000ULL) * (PERIOD_US) / (DIVIDER)) + 500ULL) / 1000ULL)
+
+#define TIMER2_FITS(PERIOD_US,DIVIDER)      ((TIMER2_COUNTS(PERIOD_US,DIVIDER) >= 1ULL) && \
+                                             (TIMER2_COUNTS(PERIOD_US,DIVIDER) <= 256ULL))
+
+#define TIMER2_IS_DIVIDER(DIVIDER) \
+	(((DIVIDER) == 1) || ((DIVIDER) == 8) || ((DIVIDER) == 32) || ((DIVIDER) == 64) || \
+	((DIVIDER) == 128) || ((DIVIDER) == 256) || ((DIVIDER) == 1024))
+
+/* Smallest pre-scaler division reaching the period */
+#define TIMER2_DIVIDER(PERIOD_US) \
+	((TIMER2_COUNTS(PERIOD_US,1ULL) <= 256ULL) ? 1ULL : \
+	(TIMER2_COUNTS(PERIOD_US,8ULL) <= 256ULL) ? 8ULL : \
+	(TIMER2_COUNTS(PERIOD_US,32ULL) <= 256ULL) ? 32ULL : \
+	(TIMER2_COUNTS(PERIOD_US,64ULL) <= 256ULL) ? 64ULL : \
+	(TIMER2_COUNTS(PERIOD_US,128ULL) <= 256ULL) ? 128ULL : \
+	(TIMER2_COUNTS(PERIOD_US,256ULL) <= 256ULL) ? 256ULL : \
+	1024ULL)
+
+/* Clock select of a pre-scaler division */
+#define TIMER2_PRESCALER(DIVIDER) \
+	((((DIVIDER) == 1) ? TIMER2_Prescaler_1 : ((DIVIDER) == 8) ? TIMER2_Prescaler_8 : \
+	((DIVIDER) == 32) ? TIMER2_Prescaler_32 : ((DIVIDER) == 64) ? TIMER2_Prescaler_64 : \
+	((DIVIDER) == 128) ? TIMER2_Prescaler_128 : ((DIVIDER) == 256) ? TIMER2_Prescaler_256 : \
+	((DIVIDER) == 1024) ? TIMER2_Prescaler_1024 : \
+	TIMER2_No_Clock) + \
+	STATIC_CHECK(TIMER2_IS_DIVIDER(DIVIDER)))
+
+/* Compare value (TOP) of a period at a pre-scaler division */
+#define TIMER2_COMPARE(PERIOD_US,DIVIDER) \
+	((uint8)(TIMER2_COUNTS(PERIOD_US,DIVIDER) - 1ULL) + STATIC_CHECK(TIMER2_FITS(PERIOD_US,DIVIDER)))
+
+#define TIMER2_CTC_CONFIG_US(PERIOD_US) \
+	{0, TIMER2_COMPARE(PERIOD_US,TIMER2_DIVIDER(PERIOD_US)), TIMER2_PRESCALER(TIMER2_DIVIDER(PERIOD_US)), TIMER2_CTC_2}
+
+#define TIMER2_CTC_CONFIG_MS(PERIOD_MS)     TIMER2_CTC_CONFIG_US((PERIOD_MS) * 1000ULL)
+
+/****************************************************************************************
+ *                                      Types Declaration                               *
+ ****************************************************************************************/
+
+/* Timer2 has its own pre-scalers (32 and 128 instead of the external clock of Timer0) */
+typedef enum
+{
+	TIMER2_No_Clock,
+	TIMER2_Prescaler_1,
+	TIMER2_Prescaler_8,
+	TIMER2_Prescaler_32,
+	TIMER2_Prescaler_64,
+	TIMER2_Prescaler_128,
+	TIMER2_Prescaler_256,
+	TIMER2_Prescaler_1024
+}Timer2_Clock_Select;
+
+typedef enum
+{
+	TIMER2_Normal_0,
+	TIMER2_CTC_2 = 2
+}Timer2_Mode;
+
+typedef struct
+{
+	uint8 Initial_Value;
+	uint8 Compare_Value;
+	Timer2_Clock_Select Prescalar;
+	Timer2_Mode Timer_Mode;
+}Timer2_ConfigType;
+
+/****************************************************************************************
+ *                                      Functions Prototypes                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Initialization of Timer2 (Enable Timer2)
+ * 1. Let the TCNT2 Register = The Start value of the timer.
+ * 2. Enable CS22:0 bits according to the required pre-scalar.
+ * 3. Configure the TCCR2 Register according to the Timer2 Mode.
+ * 4. In CTC Mode Let OCR2 = the compare value (TOP Value).
+ * 5. Enable the interrupt of the mode (TOIE2 or OCIE2) without touching the bits of the other timers.
+ */
+void Timer2_NonPWM_Mode_Init(const Timer2_ConfigType* Config_Ptr);
+
+/*
+ * Description:
+ * De-initialization of Timer2 (Disable)
+ */
+void Timer2_DeInit(void);
+
+/*
+ * Description:
+ * Function to read the current count of Timer2 (TCNT2).
+ */
+uint8 Timer2_GetCount(void);
+
+/*
+ * Description:
+ * Function to tell if a compare match happened that its interrupt didn't serve yet (OCF2 still set).
+ */
+boolean Timer2_IsComparePending(void);
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void Timer2_SetCallBack(void(*a_ptr)(void));
+
+#endif /* TIMER2_H_ */
@@ -6,8 +6,72 @@
  ****************************************************************************************************************/
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
 #include "UART.h"
 #include "Common_Macros.h"
+#include "Profile.h"
+#include "Tick.h"
+
+#define UART_RX_BUFFER_MASK                  (UART_RX_BUFFER_SIZE - 1)
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Received bytes, filled by the receive interrupt */
+static volatile uint8 g_RxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_RxHead = 0;
+static volatile uint8 g_RxCount = 0;
+static volatile uint8 g_RxLostBytes = 0;
+
+/* Frames sent to another receiver on the line, dropped from their start byte to their end byte included */
+static volatile uint8 g_FrameStart = 0;
+static volatile uint8 g_FrameEnd = 0;
+static volatile boolean g_InFrame = FALSE;
+
+/* Global variables to hold the address of the call back function in the application */
+static void (*volatile g_CallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Interrupt for a received byte, reading UDR clears RXC */
+ISR(USART_RXC_vect)
+{
+	uint8 Byte = UDR;
+
+	if (g_InFrame)
+	{
+		g_InFrame = (Byte != g_FrameEnd);
+		return;
+	}
+
+	if ((Byte == g_FrameStart) && (g_FrameStart != g_FrameEnd))
+	{
+		g_InFrame = TRUE;
+		return;
+	}
+
+	if (g_RxCount >= UART_RX_BUFFER_SIZE)
+	{
+		if (g_RxLostBytes != 0xFF)
+		{
+			g_RxLostBytes++;
+		}
+		return;
+	}
+
+	g_RxBuffer[(g_RxHead + g_RxCount) & UART_RX_BUFFER_MASK] = Byte;
+	g_RxCount++;
+
+	/* One notification per burst, the application reads until the buffer is empty */
+	if ((g_RxCount == 1) && (g_CallBackPtr != NULL_PTR))
+	{
+		(*g_CallBackPtr)();
+	}
+}
 
 /****************************************************************************************
  *                                     Functions Definitions                            *
@@ -29,8 +93,9 @@ void UART_Init(const UART_ConfigType *Config_Ptr)
 	uint16 UBRR_Value = 0;
 
 	SET_BIT(UCSRC,URSEL);
-	/* Let the device as a receiver by enable RXEN bit */
+	/* Let the device as a receiver by enable RXEN bit, every received byte is buffered by the interrupt */
 	SET_BIT(UCSRB, RXEN);
+	SET_BIT(UCSRB, RXCIE);
 	/* Let the device as a transmitter by enable TXEN bit */
 	SET_BIT(UCSRB, TXEN);
 
@@ -144,22 +209,121 @@ void UART_Init(const UART_ConfigType *Config_Ptr)
  */
 void UART_SendByte(uint8 Byte)
 {
+	PROFILE_ENTER(PROFILE_UART_SEND_BYTE);
+
 	while BIT_IS_CLEAR(UCSRA,UDRE);
 	UDR = Byte;
+
+	PROFILE_EXIT(PROFILE_UART_SEND_BYTE);
 }
 
 /*
  * Description:
  * Function to receive byte from the another device.
- * 1. RXC bit is set automatically when the received buffer Rx hasn't any unread data.
- * 2. We wait until the all data is read.
- * 3. Then, we can read the received data from the Rx buffer through UDR Register.
- * 4. After read the data, the RXC flag will be cleared.
+ * 1. The receive interrupt (RXCIE) moves every received byte from UDR into the receive buffer.
+ * 2. We sleep (Idle mode) until the buffer holds a byte, the I-bit must be set.
+ * 3. Then, we take the oldest byte out of the buffer.
  */
 uint8 UART_ReceiveByte(void)
 {
-	while BIT_IS_CLEAR(UCSRA,RXC);
-	return UDR;
+	uint8 Byte;
+
+	/* The buffer is checked with the interrupts disabled, SEI lets the SLEEP run before any interrupt */
+	cli();
+	while (g_RxCount == 0)
+	{
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+		cli();
+	}
+	sei();
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Byte = g_RxBuffer[g_RxHead];
+		g_RxHead = (g_RxHead + 1) & UART_RX_BUFFER_MASK;
+		g_RxCount--;
+	}
+
+	return Byte;
+}
+
+/*
+ * Description:
+ * Function to receive byte from the another device within the given milliseconds, like UART_ReceiveByte.
+ * The tick interrupt wakes the sleep every msec to check the time, the Tick service must run.
+ * Returns FALSE if no byte was received in time.
+ */
+boolean UART_ReceiveByteTimeout(uint8 *Byte, uint16 Timeout_Ms)
+{
+	Tick_Type Start = Tick_Now();
+
+	cli();
+	while (g_RxCount == 0)
+	{
+		if (Tick_Elapsed(Start) >= Timeout_Ms)
+		{
+			sei();
+			return FALSE;
+		}
+
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+		cli();
+	}
+	sei();
+
+	/* A byte is waiting, no sleep */
+	*Byte = UART_ReceiveByte();
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Return TRUE if a received byte is waiting in the receive buffer, without waiting for it.
+ */
+boolean UART_IsByteReceived(void)
+{
+	return (g_RxCount != 0) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Function to set the Call Back function address, called from the receive interrupt when a byte arrives into
+ * an empty receive buffer. The application reads every waiting byte after it.
+ */
+void UART_SetCallBack(void(*a_ptr)(void))
+{
+	g_CallBackPtr = a_ptr;
+}
+
+/*
+ * Description:
+ * Return the number of received bytes lost because the receive buffer was full (saturated at 0xFF).
+ */
+uint8 UART_GetLostBytes(void)
+{
+	return g_RxLostBytes;
+}
+
+/*
+ * Description:
+ * Drop the received frames from Start_Byte to End_Byte included in the receive interrupt (the text sent on
+ * the line for another receiver), none of their bytes is buffered. Equal bytes keep every byte.
+ */
+void UART_SetIgnoredFrame(uint8 Start_Byte, uint8 End_Byte)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_FrameStart = Start_Byte;
+		g_FrameEnd = End_Byte;
+		g_InFrame = FALSE;
+	}
 }
 
 /*
@@ -0,0 +1,126 @@
+/*****************************************************************************************************************
+ * File Name: Watchdog.c
+ * Date: 18/10/2026
+ * Driver: Watchdog Supervision with Stage Checkpoints Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/wdt.h>
+#include <avr/eeprom.h>
+#include "Watchdog.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Survives the watchdog reset: the start-up code leaves the .noinit section as it is */
+static volatile uint8 g_Stage __attribute__((section(".noinit")));
+
+static Watchdog_RecordType g_Record = {WATCHDOG_NO_STAGE, 0};
+static boolean g_WasReset = FALSE;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return the check byte of a record.
+ */
+static uint8 Watchdog_Check(const uint8 *Record)
+{
+	return (uint8)~(Record[0] + Record[1] + Record[2]);
+}
+
+/*
+ * Description:
+ * Read the record from the internal EEPROM, an erased or torn record reads as no reset.
+ */
+static void Watchdog_ReadRecord(void)
+{
+	uint8 Record[WATCHDOG_RECORD_SIZE];
+
+	eeprom_read_block(Record, (const void *)WATCHDOG_RECORD_ADDRESS, WATCHDOG_RECORD_SIZE);
+
+	if (Record[3] == Watchdog_Check(Record))
+	{
+		g_Record.Stage = Record[0];
+		g_Record.Resets = (uint16)Record[1] | ((uint16)Record[2] << 8);
+	}
+}
+
+/*
+ * Description:
+ * Write the record to the internal EEPROM (only the changed bytes are written).
+ */
+static void Watchdog_WriteRecord(void)
+{
+	uint8 Record[WATCHDOG_RECORD_SIZE];
+
+	Record[0] = g_Record.Stage;
+	Record[1] = (uint8)g_Record.Resets;
+	Record[2] = (uint8)(g_Record.Resets >> 8);
+	Record[3] = Watchdog_Check(Record);
+
+	eeprom_update_block(Record, (void *)WATCHDOG_RECORD_ADDRESS, WATCHDOG_RECORD_SIZE);
+	eeprom_busy_wait();
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Read the reset cause, save the stuck stage in the internal EEPROM record after a watchdog reset, then start
+ * the watchdog (WATCHDOG_PERIOD). Must be called first in main, before any long step.
+ */
+void Watchdog_Init(void)
+{
+	/* The flags stay set until cleared, a later external reset mustn't read as a watchdog one */
+	g_WasReset = (MCUCSR & (1<<WDRF)) ? TRUE : FALSE;
+	MCUCSR &= ~(1<<WDRF);
+
+	Watchdog_ReadRecord();
+
+	if (g_WasReset)
+	{
+		g_Record.Stage = g_Stage;
+		if (g_Record.Resets != 0xFFFF)
+		{
+			g_Record.Resets++;
+		}
+		Watchdog_WriteRecord();
+	}
+
+	g_Stage = WATCHDOG_NO_STAGE;
+	wdt_enable(WATCHDOG_PERIOD);
+}
+
+/*
+ * Description:
+ * Tell the stage starting (or still running) and restart the watchdog period.
+ */
+void Watchdog_Checkpoint(uint8 Stage)
+{
+	g_Stage = Stage;
+	wdt_reset();
+}
+
+/*
+ * Description:
+ * Return TRUE if this boot follows a watchdog reset.
+ */
+boolean Watchdog_WasReset(void)
+{
+	return g_WasReset;
+}
+
+/*
+ * Description:
+ * Return the record of the watchdog resets kept in the internal EEPROM.
+ */
+const Watchdog_RecordType* Watchdog_GetRecord(void)
+{
+	return &g_Record;
+}
@@ -0,0 +1,220 @@
+/*****************************************************************************************************************
+ * File Name: ConstantTime_Test.c
+ * Date: 18/10/2026
+ * Driver: Host Timing Test of the Constant-Time Comparison
+ * Author: Youssef Zaki
+ *
+ * Times ConstantTime_IsEqual, compiled unchanged in its own object, on blocks differing at every position (by
+ * 0x01, 0x80 and 0xFF) against equal blocks of the same length. Each position is timed in TEST_BATCHES
+ * pairs of batches of calls, equal blocks then the difference back to back, and graded by the median of the
+ * ratios of the pairs: a drift of the clock speed slows both batches of a pair, the median drops the pairs
+ * hit by an interrupt or a preemption.
+ * Passes if every comparison returns the right result and no position is more than TEST_TOLERANCE_PERCENT
+ * faster or slower than the equal blocks in TEST_TIMINGS timings in a row: an early exit, or a branch on the
+ * data of the object built costing more than the bound, is detected. A smaller dependency is not. It proves
+ * it for the host object only: the AVR object is not covered, its cycle count for the same blocks has to be
+ * read in an AVR simulator.
+ * gcc -O2 -DF_CPU=8000000UL -I. -I../Control_ECU ConstantTime_Test.c ../Control_ECU/ConstantTime.c
+ *     -o ConstantTime_Test && ./ConstantTime_Test
+ ****************************************************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "ConstantTime.h"
+#include "Credential.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+#define TEST_MAX_LENGTH                      255
+
+/* Calls timed together, about 16 KB compared per batch, and pairs of batches timed for every position */
+#define TEST_BATCH_BYTES                     16384UL
+#define TEST_BATCHES                         25
+
+/* Timings of a position out of the bound before it fails */
+#define TEST_TIMINGS                         5
+
+/* Largest difference allowed between a position and the equal blocks (an early exit halves the time at mid) */
+#define TEST_TOLERANCE_PERCENT               10
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* The compared lengths: a PIN, a digest, and the extremes */
+static const uint8 g_Lengths[] = {1, CREDENTIAL_PIN_SIZE, CREDENTIAL_DIGEST_SIZE, TEST_MAX_LENGTH};
+
+#define TEST_LENGTHS_NUMBER                  (sizeof(g_Lengths) / sizeof(g_Lengths[0]))
+
+/* The differences set at every position: the lowest bit, the highest bit, every bit */
+static const uint8 g_Differences[] = {0x01, 0x80, 0xFF};
+
+#define TEST_DIFFERENCES_NUMBER              (sizeof(g_Differences) / sizeof(g_Differences[0]))
+
+/* Results of every call, kept so the calls aren't dropped */
+static volatile boolean g_Sink;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return the time in nsec of one batch of Calls comparisons.
+ */
+static double Test_TimeBatch(const uint8 *Block_A, const uint8 *Block_B, uint8 Length, unsigned long Calls)
+{
+	struct timespec Start;
+	struct timespec End;
+	unsigned long Call;
+
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	for (Call = 0; Call < Calls; Call++)
+	{
+		g_Sink = ConstantTime_IsEqual(Block_A, Block_B, Length);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+
+	return ((double)(End.tv_sec - Start.tv_sec) * 1e9) + (double)(End.tv_nsec - Start.tv_nsec);
+}
+
+/*
+ * Description:
+ * Time the equal blocks (A, A_Copy) and the different ones (A, B) in alternate batches, TEST_BATCHES pairs, and
+ * return the median of the ratios of the pairs (different over equal). The batches of a pair run back to back,
+ * a drift of the clock speed slows both, and the median drops the pairs hit by an interrupt or a preemption.
+ */
+static double Test_TimeRatio(const uint8 *Block_A, const uint8 *Block_A_Copy, const uint8 *Block_B, uint8 Length,
+		unsigned long Calls)
+{
+	double Ratios[TEST_BATCHES];
+	double Ratio;
+	uint8 Batch;
+	uint8 i;
+
+	for (Batch = 0; Batch < TEST_BATCHES; Batch++)
+	{
+		Ratio = Test_TimeBatch(Block_A, Block_A_Copy, Length, Calls);
+		Ratio = Test_TimeBatch(Block_A, Block_B, Length, Calls) / Ratio;
+
+		/* Insertion in order */
+		for (i = Batch; (i > 0) && (Ratios[i - 1] > Ratio); i--)
+		{
+			Ratios[i] = Ratios[i - 1];
+		}
+		Ratios[i] = Ratio;
+	}
+
+	return Ratios[TEST_BATCHES / 2];
+}
+
+/*
+ * Description:
+ * Return how much the different blocks take more or less time than the equal ones, in percent.
+ */
+static double Test_Deviation(const uint8 *Block_A, const uint8 *Block_A_Copy, const uint8 *Block_B, uint8 Length,
+		unsigned long Calls)
+{
+	double Deviation = (Test_TimeRatio(Block_A, Block_A_Copy, Block_B, Length, Calls) - 1.0) * 100.0;
+
+	return (Deviation < 0) ? -Deviation : Deviation;
+}
+
+/*
+ * Description:
+ * Time every difference at every position of one length against the equal blocks and check the results.
+ * Returns the number of failed comparisons, the largest difference of time in Worst (percent).
+ */
+static unsigned long Test_Length(uint8 Length, double *Worst)
+{
+	uint8 Block_A[TEST_MAX_LENGTH] = {0};
+	uint8 Block_A_Copy[TEST_MAX_LENGTH] = {0};
+	uint8 Block_B[TEST_MAX_LENGTH] = {0};
+	unsigned long Calls = (TEST_BATCH_BYTES / Length) + 1;
+	unsigned long Failures = 0;
+	double Deviation;
+	uint8 Timing;
+	uint16 Position;
+	uint8 i;
+
+	*Worst = 0;
+
+	for (Position = 0; Position < Length; Position++)
+	{
+		Block_A[Position] = (uint8)(Position * 37U + 11U);
+		Block_A_Copy[Position] = Block_A[Position];
+		Block_B[Position] = Block_A[Position];
+	}
+
+	if (!ConstantTime_IsEqual(Block_A, Block_A_Copy, Length))
+	{
+		printf("length %u: equal blocks compared different\n", Length);
+		Failures++;
+	}
+
+	for (Position = 0; Position < Length; Position++)
+	{
+		for (i = 0; i < TEST_DIFFERENCES_NUMBER; i++)
+		{
+			Block_B[Position] = (uint8)(Block_A[Position] ^ g_Differences[i]);
+
+			if (ConstantTime_IsEqual(Block_A, Block_B, Length))
+			{
+				printf("length %u: difference 0x%02X at %u compared equal\n", Length, g_Differences[i], Position);
+				Failures++;
+			}
+
+			/* Out of the bound TEST_TIMINGS times in a row fails, a burst of preemptions doesn't */
+			Timing = 0;
+			do
+			{
+				Deviation = Test_Deviation(Block_A, Block_A_Copy, Block_B, Length, Calls);
+				Timing++;
+			}while ((Deviation > TEST_TOLERANCE_PERCENT) && (Timing < TEST_TIMINGS));
+
+			if (Deviation > TEST_TOLERANCE_PERCENT)
+			{
+				printf("length %u: difference 0x%02X at %u took %.1f %% more or less than equal blocks\n",
+						Length, g_Differences[i], Position, Deviation);
+				Failures++;
+			}
+
+			if (Deviation > *Worst)
+			{
+				*Worst = Deviation;
+			}
+
+			Block_B[Position] = Block_A[Position];
+		}
+	}
+
+	return Failures;
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+int main(void)
+{
+	unsigned long Failures = 0;
+	double Worst;
+	uint8 i;
+
+	for (i = 0; i < TEST_LENGTHS_NUMBER; i++)
+	{
+		Failures += Test_Length(g_Lengths[i], &Worst);
+		printf("length %u: largest difference of time %.1f %%\n", g_Lengths[i], Worst);
+	}
+
+	if (Failures != 0)
+	{
+		printf("FAIL: %lu comparisons\n", Failures);
+		return 1;
+	}
+
+	printf("PASS: the time doesn't depend on the position of the difference (%d %% bound)\n",
+			TEST_TOLERANCE_PERCENT);
+	return 0;
+}
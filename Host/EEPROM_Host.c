@@ -0,0 +1,60 @@
+/*****************************************************************************************************************
+ * File Name: EEPROM_Host.c
+ * Date: 18/10/2026
+ * Driver: Host Emulation of the AVR Internal EEPROM Source File
+ * Author: Youssef Zaki
+ *
+ * Defines the emulated internal EEPROM of avr/eeprom.h once, every translation unit reads and writes the same
+ * bytes. Built with every host application using the internal EEPROM (the mirror tier, the watchdog record),
+ * see the example of I2C_Host.c.
+ ****************************************************************************************************************/
+#include <string.h>
+#include <avr/eeprom.h>
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+uint8_t g_Host_Internal_EEPROM[E2END + 1];
+int g_Host_Internal_EEPROM_Erased = 0;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Erase the emulated EEPROM (0xFF) at the first access, like a new part.
+ */
+static void Host_Internal_EEPROM_Erase(void)
+{
+	if (!g_Host_Internal_EEPROM_Erased)
+	{
+		memset(g_Host_Internal_EEPROM, 0xFF, sizeof(g_Host_Internal_EEPROM));
+		g_Host_Internal_EEPROM_Erased = 1;
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Read a block of the emulated EEPROM, Source is the EEPROM address.
+ */
+void eeprom_read_block(void *Destination, const void *Source, size_t Length)
+{
+	Host_Internal_EEPROM_Erase();
+	memcpy(Destination, &g_Host_Internal_EEPROM[(uintptr_t)Source], Length);
+}
+
+/*
+ * Description:
+ * Write a block of the emulated EEPROM, Destination is the EEPROM address.
+ */
+void eeprom_update_block(const void *Source, void *Destination, size_t Length)
+{
+	Host_Internal_EEPROM_Erase();
+	memcpy(&g_Host_Internal_EEPROM[(uintptr_t)Destination], Source, Length);
+}
@@ -0,0 +1,428 @@
+/*****************************************************************************************************************
+ * File Name: I2C_Host.c
+ * Date: 18/10/2026
+ * Driver: Host Emulation of the I2C Driver with a 24Cxx EEPROM Source File
+ * Author: Youssef Zaki
+ *
+ * Replaces I2C.c on Linux: the I2C driver API is answered by emulated EEPROM_PART chips whose contents live in a
+ * memory-mapped file, so the unchanged EEPROM driver and the storage services above it run on the host.
+ * The emulation models the page buffer (writes wrap inside the page), the internal write cycle (no
+ * acknowledge until it ends), the sequential read address wrap at the end of the chip and the bus time
+ * at the configured SCL frequency. Example:
+ * gcc -DF_CPU=8000000UL -I. -I../Control_ECU I2C_Host.c EEPROM_Host.c ../Control_ECU/EEPROM.c ../Control_ECU/NVM.c
+ *     ../Control_ECU/NVM_24Cxx.c ../Control_ECU/NVM_Internal.c ../Control_ECU/NVM_Mirror.c ../Control_ECU/NVM_Layout.c
+ *     ../Control_ECU/CRC.c ../Control_ECU/BLAKE2s.c ../Control_ECU/ConstantTime.c ../Control_ECU/Credential.c
+ *     <application>.c
+ ****************************************************************************************************************/
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "I2C.h"
+#include "EEPROM.h"
+#include "I2C_Host.h"
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef enum
+{
+	TWI_HOST_IDLE,               /* bus released */
+	TWI_HOST_SLAVE_ADDRESS,      /* START sent, next byte is the device address */
+	TWI_HOST_WORD_ADDRESS_HIGH,  /* device selected for write, next byte is the memory address high byte */
+	TWI_HOST_WORD_ADDRESS,       /* device selected for write, next byte is the memory address (low byte) */
+	TWI_HOST_WRITE_DATA,         /* data bytes go to the page buffer */
+	TWI_HOST_READ_DATA,          /* device selected for read */
+	TWI_HOST_NOT_ACKNOWLEDGED    /* the device ignored its address, bus waits for STOP */
+}TWI_Host_State;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static uint8 *g_Memory = NULL;
+static int g_File = -1;
+
+static TWI_Host_State g_State = TWI_HOST_IDLE;
+static uint8 g_Status = TWI_NO_INFO;
+
+/* Internal address counter of the EEPROM (kept between transactions for current address reads) */
+static uint32 g_Address = 0;
+
+/* Page buffer, written to the memory at STOP only */
+static uint8 g_PageBuffer[TWI_HOST_EEPROM_PAGE_SIZE];
+static boolean g_PageWritten[TWI_HOST_EEPROM_PAGE_SIZE];
+static boolean g_PageDirty = FALSE;
+static uint32 g_PageBase = 0;
+
+/* Simulated time at which the running write cycle ends */
+static uint64 g_BusyUntil_NS = 0;
+
+/* Duration of one SCL period, 100 kHz until TWI_Init */
+static uint32 g_BitTime_NS = 10000;
+
+static TWI_Host_StatisticsType g_Statistics;
+static TWI_ErrorCountersType g_TWI_ErrorCounters;
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Forget the bytes of the page buffer (STOP after the write cycle started, or a repeated START).
+ */
+static void TWI_Host_DropPage(void)
+{
+	memset(g_PageWritten, FALSE, sizeof(g_PageWritten));
+	g_PageDirty = FALSE;
+}
+
+/*
+ * Description:
+ * First address of the chip selected by the device address (always 0 for the 24C16).
+ */
+static uint32 TWI_Host_ChipBase(uint8 Device_Address)
+{
+#if (EEPROM_ADDRESS_BYTES == 1)
+	(void)Device_Address;
+	return 0;
+#else
+	return (uint32)((Device_Address >> 1) & 0x07) * EEPROM_SIZE;
+#endif
+}
+
+static void TWI_Host_BusTime(uint8 Bits)
+{
+	g_Statistics.Bus_Time_NS += (uint64)Bits * g_BitTime_NS;
+	g_Statistics.Total_Time_NS += (uint64)Bits * g_BitTime_NS;
+}
+
+/****************************************************************************************
+ *                                  Host Functions Definitions                          *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Map the file holding the emulated EEPROM contents, a new file is created erased (0xFF).
+ */
+uint8 TWI_Host_Open(const char *Path)
+{
+	struct stat file_status;
+	off_t old_size;
+
+	TWI_Host_Close();
+
+	g_File = open(Path, O_RDWR | O_CREAT, 0644);
+	if ((g_File < 0) || (fstat(g_File, &file_status) != 0))
+	{
+		return ERROR;
+	}
+
+	old_size = file_status.st_size;
+	if ((old_size < TWI_HOST_EEPROM_SIZE) && (ftruncate(g_File, TWI_HOST_EEPROM_SIZE) != 0))
+	{
+		return ERROR;
+	}
+
+	g_Memory = mmap(NULL, TWI_HOST_EEPROM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, g_File, 0);
+	if (g_Memory == MAP_FAILED)
+	{
+		g_Memory = NULL;
+		return ERROR;
+	}
+
+	/* The new part of the file is an erased EEPROM */
+	if (old_size < TWI_HOST_EEPROM_SIZE)
+	{
+		memset(g_Memory + old_size, 0xFF, TWI_HOST_EEPROM_SIZE - old_size);
+	}
+
+	g_State = TWI_HOST_IDLE;
+	TWI_Host_DropPage();
+	g_BusyUntil_NS = 0;
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Flush the contents to the file and unmap it.
+ */
+void TWI_Host_Close(void)
+{
+	if (g_Memory != NULL)
+	{
+		msync(g_Memory, TWI_HOST_EEPROM_SIZE, MS_SYNC);
+		munmap(g_Memory, TWI_HOST_EEPROM_SIZE);
+		g_Memory = NULL;
+	}
+
+	if (g_File >= 0)
+	{
+		close(g_File);
+		g_File = -1;
+	}
+}
+
+/*
+ * Description:
+ * Advance the simulated time, used by the host util/delay.h for _delay_ms and _delay_us.
+ */
+void TWI_Host_Delay(uint32 Microseconds)
+{
+	g_Statistics.Total_Time_NS += (uint64)Microseconds * 1000;
+}
+
+/*
+ * Description:
+ * Return / clear the counters of the emulated bus.
+ */
+const TWI_Host_StatisticsType* TWI_Host_GetStatistics(void)
+{
+	return &g_Statistics;
+}
+
+void TWI_Host_ResetStatistics(void)
+{
+	uint64 now = g_Statistics.Total_Time_NS;
+
+	memset(&g_Statistics, 0, sizeof(g_Statistics));
+
+	/* Keep the time base, a running write cycle still has to end */
+	g_Statistics.Total_Time_NS = now;
+}
+
+/****************************************************************************************
+ *                                 I2C Driver Functions Definitions                     *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Only the bit rate matters on the host: SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS)
+ */
+void TWI_Init(TWI_ConfigType *Config_Ptr)
+{
+	uint32 prescaler = 1UL << (2 * (Config_Ptr -> I2C_Prescaler));
+	uint32 scl = F_CPU / (16UL + (2UL * (Config_Ptr -> I2C_Bit_Rate) * prescaler));
+
+	g_BitTime_NS = (uint32)(1000000000UL / scl);
+}
+
+/*
+ * Description:
+ * START on an idle bus or repeated START, an unfinished page write is dropped like on the real part.
+ */
+void TWI_Start(void)
+{
+	if (g_State == TWI_HOST_IDLE)
+	{
+		g_Status = TWI_START;
+		g_Statistics.Transactions++;
+	}
+	else
+	{
+		g_Status = TWI_REP_START;
+		g_Statistics.Repeated_Starts++;
+	}
+
+	TWI_Host_DropPage();
+	g_State = TWI_HOST_SLAVE_ADDRESS;
+	TWI_Host_BusTime(1);
+}
+
+/*
+ * Description:
+ * STOP: the bytes of the page buffer are written and the internal write cycle starts.
+ */
+void TWI_Stop(void)
+{
+	uint8 i;
+
+	if ((g_State == TWI_HOST_WRITE_DATA) && g_PageDirty)
+	{
+		for (i = 0; i < TWI_HOST_EEPROM_PAGE_SIZE; i++)
+		{
+			if (g_PageWritten[i])
+			{
+				g_Memory[g_PageBase + i] = g_PageBuffer[i];
+			}
+		}
+
+		g_Statistics.Write_Cycles++;
+		g_BusyUntil_NS = g_Statistics.Total_Time_NS + ((uint64)TWI_HOST_WRITE_CYCLE_US * 1000);
+	}
+
+	TWI_Host_DropPage();
+	g_State = TWI_HOST_IDLE;
+	g_Status = TWI_NO_INFO;
+	TWI_Host_BusTime(1);
+}
+
+void TWI_WriteByte(uint8 Byte)
+{
+	g_Statistics.Bytes++;
+	TWI_Host_BusTime(9);
+
+	switch (g_State)
+	{
+	case TWI_HOST_SLAVE_ADDRESS:
+		/* A busy (or another) device doesn't acknowledge its address */
+		if (((Byte & 0xF0) != TWI_HOST_EEPROM_DEVICE_ADDRESS) || (g_Memory == NULL) ||
+			(g_Statistics.Total_Time_NS < g_BusyUntil_NS) ||
+			((EEPROM_ADDRESS_BYTES == 2) && (((Byte >> 1) & 0x07) >= EEPROM_CHIPS)))
+		{
+			g_Status = (Byte & 1) ? TWI_MT_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+			g_Statistics.Nacks++;
+			g_State = TWI_HOST_NOT_ACKNOWLEDGED;
+		}
+		else if (Byte & 1)
+		{
+			/* Read from the internal address counter (of the selected chip) */
+			g_Status = TWI_MT_SLA_R_ACK;
+			g_Address = TWI_Host_ChipBase(Byte) + (g_Address % EEPROM_SIZE);
+			g_State = TWI_HOST_READ_DATA;
+		}
+		else
+		{
+			/* 24C16: A8 A9 A10 are in the device address, larger parts: the chip select bits */
+			g_Status = TWI_MT_SLA_W_ACK;
+#if (EEPROM_ADDRESS_BYTES == 1)
+			g_Address = (uint32)(((Byte >> 1) & 0x07) << 8);
+			g_State = TWI_HOST_WORD_ADDRESS;
+#else
+			g_Address = TWI_Host_ChipBase(Byte);
+			g_State = TWI_HOST_WORD_ADDRESS_HIGH;
+#endif
+		}
+		break;
+
+	case TWI_HOST_WORD_ADDRESS_HIGH:
+		g_Address |= ((uint32)Byte << 8) % EEPROM_SIZE;
+		g_Status = TWI_MT_DATA_ACK;
+		g_State = TWI_HOST_WORD_ADDRESS;
+		break;
+
+	case TWI_HOST_WORD_ADDRESS:
+		g_Address = (g_Address & ~(uint32)0xFF) | Byte;
+		g_PageBase = g_Address & ~(uint32)(TWI_HOST_EEPROM_PAGE_SIZE - 1);
+		g_Status = TWI_MT_DATA_ACK;
+		g_State = TWI_HOST_WRITE_DATA;
+		break;
+
+	case TWI_HOST_WRITE_DATA:
+		g_PageBuffer[g_Address - g_PageBase] = Byte;
+		g_PageWritten[g_Address - g_PageBase] = TRUE;
+		g_PageDirty = TRUE;
+		g_Statistics.Data_Bytes_Written++;
+
+		/* The address counter rolls over inside the page */
+		g_Address = g_PageBase + ((g_Address + 1) & (TWI_HOST_EEPROM_PAGE_SIZE - 1));
+		g_Status = TWI_MT_DATA_ACK;
+		break;
+
+	default:
+		/* Writing without an addressed device */
+		g_Status = TWI_BUS_ERROR;
+		break;
+	}
+}
+
+/*
+ * Description:
+ * Sequential read, the address counter rolls over from the end of the chip to its start.
+ */
+static uint8 TWI_Host_ReadByte(uint8 Status)
+{
+	uint8 data;
+
+	g_Statistics.Bytes++;
+	TWI_Host_BusTime(9);
+
+	if (g_State != TWI_HOST_READ_DATA)
+	{
+		g_Status = TWI_BUS_ERROR;
+		return 0xFF;
+	}
+
+	data = g_Memory[g_Address];
+	g_Address = (g_Address - (g_Address % EEPROM_SIZE)) + ((g_Address + 1) % EEPROM_SIZE);
+	g_Statistics.Data_Bytes_Read++;
+	g_Status = Status;
+
+	return data;
+}
+
+uint8 TWI_ReadByteWithACK(void)
+{
+	return TWI_Host_ReadByte(TWI_MR_DATA_ACK);
+}
+
+uint8 TWI_ReadByteWithNACK(void)
+{
+	return TWI_Host_ReadByte(TWI_MR_DATA_NACK);
+}
+
+uint8 TWI_GetStatus(void)
+{
+	return g_Status;
+}
+
+/*
+ * Description:
+ * Same failure classes as the target driver, the emulated bus never needs a recovery.
+ */
+void TWI_HandleError(uint8 Status)
+{
+	switch (Status)
+	{
+	case TWI_NO_INFO:
+		g_TWI_ErrorCounters.Timeouts++;
+		break;
+
+	case TWI_MT_SLA_W_NACK:
+	case TWI_MT_DATA_NACK:
+	case TWI_MT_SLA_R_NACK:
+		g_TWI_ErrorCounters.Nacks++;
+		break;
+
+	case TWI_BUS_ERROR:
+		g_TWI_ErrorCounters.Bus_Errors++;
+		break;
+
+	case TWI_ARBITRATION_LOST:
+		g_TWI_ErrorCounters.Arbitration_Lost++;
+		break;
+
+	default:
+		g_TWI_ErrorCounters.Unexpected_Status++;
+		break;
+	}
+
+	TWI_Stop();
+}
+
+void TWI_BusRecovery(void)
+{
+	g_TWI_ErrorCounters.Recoveries++;
+}
+
+const TWI_ErrorCountersType* TWI_GetErrorCounters(void)
+{
+	return &g_TWI_ErrorCounters;
+}
+
+/* No supervisor on the emulated bus, the slave mode is accepted and never addressed */
+void TWI_Slave_Init(volatile uint8 *Registers, uint8 Size, uint8 Writable_Start)
+{
+	(void)Registers;
+	(void)Size;
+	(void)Writable_Start;
+}
+
+void TWI_Slave_SetCallBack(void(*a_ptr)(void))
+{
+	(void)a_ptr;
+}
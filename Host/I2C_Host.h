@@ -0,0 +1,76 @@
+/*****************************************************************************************************************
+ * File Name: I2C_Host.h
+ * Date: 18/10/2026
+ * Driver: Host Emulation of the I2C Driver with a 24C16 EEPROM Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "EEPROM.h"
+
+#ifndef I2C_HOST_H_
+#define I2C_HOST_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Emulated EEPROM_PART chips (EEPROM_CHIPS of them), the default is one 24C16: 2 KB, 16 bytes pages,
+ * device address 1010 A10 A9 A8 R/W. The larger parts use 1010 A2 A1 A0 R/W and two address bytes.
+ */
+#define TWI_HOST_EEPROM_SIZE                 EEPROM_TOTAL_SIZE
+#define TWI_HOST_EEPROM_PAGE_SIZE            EEPROM_PAGE_SIZE
+#define TWI_HOST_EEPROM_DEVICE_ADDRESS       EEPROM_DEVICE_ADDRESS
+
+/* Typical internal write cycle, the EEPROM doesn't acknowledge its address until it ends */
+#ifndef TWI_HOST_WRITE_CYCLE_US
+#define TWI_HOST_WRITE_CYCLE_US              5000
+#endif
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	uint32 Transactions;       /* START conditions on an idle bus */
+	uint32 Repeated_Starts;
+	uint32 Bytes;              /* every byte on the bus (addresses and data) */
+	uint32 Data_Bytes_Written;
+	uint32 Data_Bytes_Read;
+	uint32 Write_Cycles;       /* internal write cycles started by a STOP after data bytes */
+	uint32 Nacks;              /* address not acknowledged (busy EEPROM or wrong device) */
+	uint64 Bus_Time_NS;        /* time the bus was busy at the configured SCL frequency */
+	uint64 Total_Time_NS;      /* bus time plus every _delay_ms/_delay_us of the firmware */
+}TWI_Host_StatisticsType;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Map the file holding the emulated EEPROM contents, a new file is created erased (0xFF).
+ */
+uint8 TWI_Host_Open(const char *Path);
+
+/*
+ * Description:
+ * Flush the contents to the file and unmap it.
+ */
+void TWI_Host_Close(void);
+
+/*
+ * Description:
+ * Advance the simulated time, used by the host util/delay.h for _delay_ms and _delay_us.
+ */
+void TWI_Host_Delay(uint32 Microseconds);
+
+/*
+ * Description:
+ * Return / clear the counters of the emulated bus.
+ */
+const TWI_Host_StatisticsType* TWI_Host_GetStatistics(void);
+void TWI_Host_ResetStatistics(void);
+
+#endif /* I2C_HOST_H_ */
@@ -0,0 +1,134 @@
+/*****************************************************************************************************************
+ * File Name: NVM_HostFile.c
+ * Date: 18/10/2026
+ * Driver: NVM Backend for a Host File Source File (Linux simulation of the Control ECU storage)
+ * Author: Youssef Zaki
+ *
+ * Built on the host together with the storage services of the Control ECU, e.g.:
+ * gcc -DF_CPU=8000000UL -DNVM_BACKEND=NVM_BACKEND_HOST_FILE -I../Control_ECU -I. ../Control_ECU/NVM.c
+ *     ../Control_ECU/NVM_Layout.c ../Control_ECU/NVM_Mirror.c ../Control_ECU/NVM_Internal.c ../Control_ECU/CRC.c
+ *     ../Control_ECU/BLAKE2s.c ../Control_ECU/ConstantTime.c ../Control_ECU/Credential.c EEPROM_Host.c
+ *     NVM_HostFile.c <application>.c
+ ****************************************************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include "EEPROM.h"
+#include "NVM.h"
+#include "NVM_HostFile.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static FILE *g_File = NULL;
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Open the file holding the NVM contents, a new file is created erased (0xFF) with NVM_HOST_FILE_SIZE bytes.
+ */
+uint8 NVM_HostFile_Open(const char *Path)
+{
+	long size;
+
+	NVM_HostFile_Close();
+
+	g_File = fopen(Path, "r+b");
+	if (g_File == NULL)
+	{
+		g_File = fopen(Path, "w+b");
+		if (g_File == NULL)
+		{
+			return ERROR;
+		}
+	}
+
+	/* Extend a new or short file with erased bytes */
+	fseek(g_File, 0, SEEK_END);
+	size = ftell(g_File);
+	while (size < NVM_HOST_FILE_SIZE)
+	{
+		fputc(0xFF, g_File);
+		size++;
+	}
+	fflush(g_File);
+
+	return SUCCESS;
+}
+
+/*
+ * Description:
+ * Flush and close the file.
+ */
+void NVM_HostFile_Close(void)
+{
+	if (g_File != NULL)
+	{
+		fclose(g_File);
+		g_File = NULL;
+	}
+}
+
+/****************************************************************************************
+ *                                     Private Functions                                *
+ ****************************************************************************************/
+
+static uint8 NVM_HostFile_Init(void)
+{
+	if (g_File == NULL)
+	{
+		return NVM_HostFile_Open(NVM_HOST_FILE_DEFAULT_PATH);
+	}
+
+	return SUCCESS;
+}
+
+static uint8 NVM_HostFile_ReadBlock(NVM_AddressType Address, uint8 *Data, uint16 Length)
+{
+	if ((g_File == NULL) || (fseek(g_File, Address, SEEK_SET) != 0))
+	{
+		return ERROR;
+	}
+
+	return (fread(Data, 1, Length, g_File) == Length) ? SUCCESS : ERROR;
+}
+
+static uint8 NVM_HostFile_WriteBlock(NVM_AddressType Address, const uint8 *Data, uint16 Length)
+{
+	if ((g_File == NULL) || (fseek(g_File, Address, SEEK_SET) != 0))
+	{
+		return ERROR;
+	}
+
+	return (fwrite(Data, 1, Length, g_File) == Length) ? SUCCESS : ERROR;
+}
+
+/*
+ * Description:
+ * Push the written bytes to the disk, the host equivalent of the end of the write cycle.
+ */
+static uint8 NVM_HostFile_Sync(void)
+{
+	if ((g_File == NULL) || (fflush(g_File) != 0))
+	{
+		return ERROR;
+	}
+
+	return (fsync(fileno(g_File)) == 0) ? SUCCESS : ERROR;
+}
+
+/****************************************************************************************
+ *                                     Backend Definition                               *
+ ****************************************************************************************/
+
+const NVM_DriverType NVM_HostFile_Driver =
+{
+	NVM_HostFile_Init,
+	NVM_HostFile_ReadBlock,
+	NVM_HostFile_WriteBlock,
+	NVM_HostFile_Sync,
+	{NVM_HOST_FILE_SIZE, NVM_HOST_FILE_PAGE_SIZE, 0}
+};
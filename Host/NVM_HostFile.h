@@ -0,0 +1,39 @@
+/*****************************************************************************************************************
+ * File Name: NVM_HostFile.h
+ * Date: 18/10/2026
+ * Driver: NVM Backend for a Host File Header File (Linux simulation of the Control ECU storage)
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef NVM_HOST_FILE_H_
+#define NVM_HOST_FILE_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Same geometry as the 24C16, so layouts tested on the host fit the real part */
+#define NVM_HOST_FILE_SIZE                   2048
+#define NVM_HOST_FILE_PAGE_SIZE              16
+
+/* File used if NVM_Init is called before NVM_HostFile_Open */
+#define NVM_HOST_FILE_DEFAULT_PATH           "nvm.bin"
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Open the file holding the NVM contents, a new file is created erased (0xFF) with NVM_HOST_FILE_SIZE bytes.
+ */
+uint8 NVM_HostFile_Open(const char *Path);
+
+/*
+ * Description:
+ * Flush and close the file.
+ */
+void NVM_HostFile_Close(void);
+
+#endif /* NVM_HOST_FILE_H_ */
@@ -0,0 +1,29 @@
+/*****************************************************************************************************************
+ * File Name: avr/eeprom.h
+ * Date: 18/10/2026
+ * Driver: Host replacement of the AVR internal EEPROM functions, the EEPROM is emulated in RAM (erased at start)
+ * Author: Youssef Zaki
+ *
+ * The emulated EEPROM is defined once in EEPROM_Host.c, which is built with every host application including
+ * this header.
+ ****************************************************************************************************************/
+#ifndef HOST_AVR_EEPROM_H_
+#define HOST_AVR_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ATmega32: 1 KB internal EEPROM */
+#define E2END                0x3FF
+
+/* Contents of the emulated EEPROM, shared by every translation unit (erased at the first access) */
+extern uint8_t g_Host_Internal_EEPROM[E2END + 1];
+extern int g_Host_Internal_EEPROM_Erased;
+
+void eeprom_read_block(void *Destination, const void *Source, size_t Length);
+
+void eeprom_update_block(const void *Source, void *Destination, size_t Length);
+
+#define eeprom_busy_wait()
+
+#endif /* HOST_AVR_EEPROM_H_ */
@@ -0,0 +1,10 @@
+/*****************************************************************************************************************
+ * File Name: avr/io.h
+ * Date: 18/10/2026
+ * Driver: Host replacement of the AVR registers header, the host drivers don't touch any register
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#endif /* HOST_AVR_IO_H_ */
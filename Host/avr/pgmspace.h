@@ -0,0 +1,13 @@
+/*****************************************************************************************************************
+ * File Name: avr/pgmspace.h
+ * Date: 18/10/2026
+ * Driver: Host replacement of the AVR program space functions, the tables stay in RAM
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#define PROGMEM
+#define pgm_read_byte(ADDRESS)               (*(const unsigned char *)(ADDRESS))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,15 @@
+/*****************************************************************************************************************
+ * File Name: util/delay.h
+ * Date: 18/10/2026
+ * Driver: Host replacement of the AVR busy-wait delays, the delays advance the simulated time
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include "I2C_Host.h"
+
+#define _delay_ms(ms)        TWI_Host_Delay((uint32)((ms) * 1000UL))
+#define _delay_us(us)        TWI_Host_Delay((uint32)(us))
+
+#endif /* HOST_UTIL_DELAY_H_ */